@@ -0,0 +1,218 @@
+#ifndef MYSQL_ORM_AGGREGATE_HPP_
+#define MYSQL_ORM_AGGREGATE_HPP_
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <CompileString/CompileString.hpp>
+#include <mysql/mysql.h>
+
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/SQLText.hpp>
+#include <mysql_orm/Statement.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/Where.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/LiftOptional.hpp>
+
+namespace mysql_orm
+{
+enum class AggregateFunction
+{
+  Count,
+  Sum,
+  Min,
+  Max,
+  Avg
+};
+
+namespace details
+{
+/** Metafunction returning the C++ type of an aggregate over `Attrs`.
+ *
+ * `COUNT(*)` is never NULL. The others are NULL on an empty set, hence
+ * optional. `SUM` is computed on 64 bits, and `AVG` as a double.
+ */
+template <AggregateFunction F, auto... Attrs>
+struct AggregateResult
+{
+  static_assert(sizeof...(Attrs) == 1,
+                "Aggregate functions take exactly one attribute");
+  using field_t = meta::LiftOptional_t<
+      meta::AttributeGetter_t<decltype((Attrs, ...))>>;
+  using type = std::optional<std::conditional_t<
+      F == AggregateFunction::Sum,
+      std::conditional_t<std::is_floating_point_v<field_t>,
+                         double,
+                         std::conditional_t<std::is_unsigned_v<field_t>,
+                                            unsigned long long,
+                                            long long>>,
+      std::conditional_t<F == AggregateFunction::Avg, double, field_t>>>;
+};
+
+template <>
+struct AggregateResult<AggregateFunction::Count>
+{
+  using type = unsigned long long;
+};
+
+template <auto Attr>
+struct AggregateResult<AggregateFunction::Count, Attr>
+{
+  using type = unsigned long long;
+};
+
+/** Returns the SQL expression computing `F` over `Attrs`.
+ */
+template <AggregateFunction F, auto... Attrs, typename Table>
+constexpr auto aggregateExpressionCS(Table const& t) noexcept
+{
+  if constexpr (F == AggregateFunction::Count)
+    return compile_string::CompileString{"COUNT(*)"};
+  else
+  {
+    auto const column =
+        '`' + t.template getColumn<Attrs...>().getName() + "`)";
+    if constexpr (F == AggregateFunction::Sum)
+      return "SUM(" + column;
+    else if constexpr (F == AggregateFunction::Min)
+      return "MIN(" + column;
+    else if constexpr (F == AggregateFunction::Max)
+      return "MAX(" + column;
+    else
+      return "AVG(" + column;
+  }
+}
+}
+
+/** Row of an `Aggregate` query, holding its single value.
+ */
+template <typename T>
+struct AggregateRow
+{
+  T value;
+};
+
+/** An aggregate query.
+ *
+ * Computes `COUNT(*)` (without attribute) or `SUM`, `MIN`, `MAX` or `AVG` of
+ * the attribute given in template arguments, server-side. The result type is
+ * deduced from the type of the attribute (see `details::AggregateResult`).
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ *
+ * The `operator()` can be used to continue the query with a `Where`. There is
+ * no `Limit`: it would apply to the single row of the result, not to the rows
+ * that are aggregated.
+ */
+template <typename Table, AggregateFunction F, auto... Attrs>
+class Aggregate
+{
+public:
+  using table_type = Table;
+  using result_type = typename details::AggregateResult<F, Attrs...>::type;
+  using model_type = AggregateRow<result_type>;
+  static inline constexpr auto query_type{QueryType::Aggregate};
+
+  constexpr Aggregate(MYSQL& mysql,
+                      Table const& t,
+                      StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
+  {
+  }
+  constexpr Aggregate(Aggregate const& b) noexcept = default;
+  constexpr Aggregate(Aggregate&& b) noexcept = default;
+  ~Aggregate() noexcept = default;
+
+  constexpr Aggregate& operator=(Aggregate const& rhs) noexcept = default;
+  constexpr Aggregate& operator=(Aggregate&& rhs) noexcept = default;
+
+  template <typename Condition>
+  constexpr WhereQuery<Aggregate, Condition> operator()(Where<Condition> where)
+  {
+    return WhereQuery<Aggregate, Condition>{
+        *this->mysql_handle, *this, *this->table, std::move(where.condition)};
+  }
+
+  auto operator()()
+  {
+    return this->build().execute();
+  }
+
+  std::string_view buildquery() const
+  {
+    return details::SQLText<Aggregate>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
+  }
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    return "SELECT " +
+           details::aggregateExpressionCS<F, Attrs...>(*this->table) +
+           " FROM `" + this->table->getName() + '`';
+  }
+
+  constexpr Statement<Aggregate, model_type> build() const
+  {
+    return Statement<Aggregate, model_type>{*this->mysql_handle, *this};
+  }
+
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
+  constexpr static size_t getNbInputSlots() noexcept
+  {
+    return 0;
+  }
+
+  constexpr static size_t getNbOutputSlots() noexcept
+  {
+    return 1;
+  }
+
+  template <std::size_t NBINDS>
+  void bindOutTo(model_type& model, OutputBindArray<NBINDS>& binds) const
+  {
+    binds.template bind<0>(0, model.value);
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void bindInTo(InputBindArray<NBINDS>&) const noexcept
+  {
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void rebindStdTmReferences(InputBindArray<NBINDS>&) const noexcept
+  {
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void finalizeBindings(MYSQL_STMT& stmt,
+                                  model_type const& bound,
+                                  model_type& model,
+                                  OutputBindArray<NBINDS>& binds)
+  {
+    binds.finalize(stmt, 0, bound.value, model.value);
+  }
+
+private:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Table const* table;
+  StatementCache* stmt_cache;
+};
+}
+
+#endif /* !MYSQL_ORM_AGGREGATE_HPP_ */
@@ -0,0 +1,34 @@
+#ifndef MYSQL_ORM_ASYNCCALLBACK_HPP_
+#define MYSQL_ORM_ASYNCCALLBACK_HPP_
+
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include <mysql_orm/QueryType.hpp>
+
+namespace mysql_orm
+{
+/** Callback called upon completion of an asynchronous query.
+ *
+ * The first argument holds the exception raised by the query, if any. `GetAll`
+ * queries also receive the rows (empty on error). Aggregate queries are not
+ * executed asynchronously.
+ */
+template <QueryType type, typename Model>
+using AsyncCallback = std::conditional_t<
+    type == QueryType::GetAll,
+    std::function<void(std::exception_ptr, std::vector<Model>)>,
+    std::function<void(std::exception_ptr)>>;
+
+// Defined in <mysql_orm/EventLoop.hpp> and <mysql_orm/AsyncQuery.hpp>, which
+// require MariaDB's client library. Queries only need them if `async` is
+// called.
+class EventLoop;
+
+template <typename Query, typename Model>
+class AsyncQuery;
+}
+
+#endif /* !MYSQL_ORM_ASYNCCALLBACK_HPP_ */
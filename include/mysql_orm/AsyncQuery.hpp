@@ -0,0 +1,166 @@
+#ifndef MYSQL_ORM_ASYNCQUERY_HPP_
+#define MYSQL_ORM_ASYNCQUERY_HPP_
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/AsyncCallback.hpp>
+#include <mysql_orm/EventLoop.hpp>
+#include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/Statement.hpp>
+
+namespace mysql_orm
+{
+/** A query executed with the non-blocking client functions.
+ *
+ * The statement is prepared (or taken from the cache) synchronously, then
+ * executed and its rows fetched on an `EventLoop`. The operation owns itself
+ * and is destroyed right before its callback is called, so that the
+ * connection can readily be used by the callback.
+ *
+ * Requires MariaDB's `_start`/`_cont` functions, and a connection made with
+ * `nonblocking` set (see `Connection`). This header is not included by
+ * queries: include it to call their `async` method.
+ */
+template <typename Query, typename Model>
+class AsyncQuery
+{
+  using Callback = AsyncCallback<Query::query_type, Model>;
+
+public:
+  static inline constexpr auto query_type{Query::query_type};
+
+  AsyncQuery(AsyncQuery const& b) = delete;
+  AsyncQuery(AsyncQuery&& b) = delete;
+  ~AsyncQuery() noexcept = default;
+
+  AsyncQuery& operator=(AsyncQuery const& rhs) = delete;
+  AsyncQuery& operator=(AsyncQuery&& rhs) = delete;
+
+  /** Starts executing `query` on `loop`.
+   *
+   * Errors occuring while preparing the statement are thrown from here. Later
+   * errors are given to `callback`.
+   */
+  static void start(Query const& query, EventLoop& loop, Callback callback)
+  {
+    auto op = std::unique_ptr<AsyncQuery>{
+        new AsyncQuery{query, loop, std::move(callback)}};
+    op->stmt.bindAll();
+    op.release()->resume(0);
+  }
+
+private:
+  enum class Phase
+  {
+    Execute,
+    Fetch
+  };
+
+  AsyncQuery(Query const& query, EventLoop& ploop, Callback pcallback)
+    : loop{&ploop},
+      callback{std::move(pcallback)},
+      stmt{query.build()},
+      phase{Phase::Execute},
+      ret{0},
+      rows{}
+  {
+  }
+
+  /** Steps through the operation until it must wait or is over.
+   *
+   * `ready` is 0 to start the current phase, or the mask of the events that
+   * occurred to continue it.
+   */
+  void resume(int ready)
+  {
+    auto error = std::exception_ptr{};
+    try
+    {
+      while (true)
+      {
+        auto const status = ready ? this->cont(ready) : this->startPhase();
+        ready = 0;
+        if (status)
+        {
+          this->loop->wait(*this->stmt.mysql_handle, status, [this](int r) {
+            this->resume(r);
+          });
+          return;
+        }
+        if (this->completePhase())
+          break;
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    this->finish(std::move(error));
+  }
+
+  int startPhase()
+  {
+    if (this->phase == Phase::Execute)
+      return mysql_stmt_execute_start(&this->ret, this->stmt.stmt.get());
+    return mysql_stmt_fetch_start(&this->ret, this->stmt.stmt.get());
+  }
+
+  int cont(int ready)
+  {
+    if (this->phase == Phase::Execute)
+      return mysql_stmt_execute_cont(&this->ret, this->stmt.stmt.get(), ready);
+    return mysql_stmt_fetch_cont(&this->ret, this->stmt.stmt.get(), ready);
+  }
+
+  /** Handles the result of the phase that just completed.
+   *
+   * Returns true if the query is over.
+   */
+  bool completePhase()
+  {
+    if (this->phase == Phase::Execute)
+    {
+      if (this->ret)
+        this->stmt.executeFailed();
+      this->phase = Phase::Fetch;
+      return query_type != QueryType::GetAll;
+    }
+    if constexpr (query_type == QueryType::GetAll)
+      if (this->stmt.decode(this->ret, this->rows.emplace_back()))
+        return false;
+    this->rows.pop_back();
+    return true;
+  }
+
+  void finish(std::exception_ptr error)
+  {
+    auto self = std::unique_ptr<AsyncQuery>{this};
+    auto cb = std::move(this->callback);
+    auto result = std::move(this->rows);
+    // Gives the statement back to its cache before the callback runs.
+    self.reset();
+    if constexpr (query_type == QueryType::GetAll)
+    {
+      if (error)
+        result.clear();
+      cb(std::move(error), std::move(result));
+    }
+    else
+      cb(std::move(error));
+  }
+
+  // May not be nullptr.
+  EventLoop* loop;
+  Callback callback;
+  Statement<Query, Model> stmt;
+  Phase phase;
+  int ret;
+  std::vector<Model> rows;
+};
+}
+
+#endif /* !MYSQL_ORM_ASYNCQUERY_HPP_ */
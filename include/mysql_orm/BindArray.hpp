@@ -4,10 +4,15 @@
 #include <array>
 #include <chrono>
 #include <cstring>
+#include <functional>
+#include <string>
 #include <type_traits>
 
 #include <mysql/mysql.h>
 
+#include <mysql_orm/Chrono.hpp>
+#include <mysql_orm/Exception.hh>
+#include <mysql_orm/meta/IsChrono.hpp>
 #include <mysql_orm/meta/IsOptional.hpp>
 #include <mysql_orm/meta/LiftOptional.hpp>
 
@@ -28,6 +33,18 @@ constexpr enum_field_types getMySQLIntegralFieldType()
     return MYSQL_TYPE_LONGLONG;
 }
 
+template <typename T,
+          typename = std::enable_if_t<std::is_floating_point_v<T>>>
+constexpr enum_field_types getMySQLFloatingFieldType()
+{
+  static_assert(sizeof(T) == sizeof(float) || sizeof(T) == sizeof(double),
+                "Unsupported floating point type");
+  if constexpr (sizeof(T) == sizeof(float))
+    return MYSQL_TYPE_FLOAT;
+  else
+    return MYSQL_TYPE_DOUBLE;
+}
+
 inline constexpr MYSQL_TIME toMySQLTime(std::tm const& tm) noexcept
 {
   auto ret = MYSQL_TIME{};
@@ -42,6 +59,11 @@ inline constexpr MYSQL_TIME toMySQLTime(std::tm const& tm) noexcept
   return ret;
 }
 
+/** Converts a `MYSQL_TIME` into a `std::tm`.
+ *
+ * The days of the week and of the year are computed without `std::mktime`,
+ * which locks the time zone. Daylight saving time is left unknown.
+ */
 inline std::tm fromMySQLTime(MYSQL_TIME const& time) noexcept
 {
   auto ret = std::tm{};
@@ -52,46 +74,164 @@ inline std::tm fromMySQLTime(MYSQL_TIME const& time) noexcept
   ret.tm_hour = time.hour;
   ret.tm_min = time.minute;
   ret.tm_sec = time.second;
+  auto const day = daysFromCivil(time.year, time.month, time.day);
+  // 1970-01-01 was a Thursday.
+  ret.tm_wday = static_cast<int>((day % 7 + 11) % 7);
+  ret.tm_yday = static_cast<int>(day - daysFromCivil(time.year, 1, 1));
   ret.tm_isdst = -1;
-  std::mktime(&ret);
   return ret;
 }
 
-// This just frees the contents and does not reinitialize it.
-// You cannot call it twice in a row with the same bind.
-inline void freeBindIfTime(MYSQL_BIND& bind)
+/** Identifies the contents of a bind array, as last given to a statement.
+ *
+ * The address tells apart arrays that moved, and the generation tells apart
+ * the states of an array.
+ */
+struct BindVersion
 {
-  if (bind.buffer_type == MYSQL_TYPE_DATETIME)
-    delete reinterpret_cast<MYSQL_TIME*>(bind.buffer);
+  MYSQL_BIND const* data{nullptr};
+  std::size_t generation{0};
+
+  constexpr bool operator==(BindVersion const& b) const noexcept
+  {
+    return this->data == b.data && this->generation == b.generation;
+  }
+};
+
+/** Metafunction returning true if values of type `T` are bound as a
+ * `MYSQL_TIME`.
+ */
+template <typename T>
+inline constexpr bool IsTime_v =
+    std::is_same_v<meta::LiftOptional_t<T>, std::tm> ||
+    meta::IsSysTime_v<meta::LiftOptional_t<T>> ||
+    meta::IsDuration_v<meta::LiftOptional_t<T>>;
+
+/** Returns the number of `Ts` bound as a `MYSQL_TIME`.
+ */
+template <typename... Ts>
+constexpr std::size_t countTimes() noexcept
+{
+  return (std::size_t{IsTime_v<Ts>} + ... + 0);
+}
+
+/** Returns true if the client library must be given `bind` again.
+ */
+inline bool bindChanged(MYSQL_BIND const& previous,
+                        MYSQL_BIND const& bind) noexcept
+{
+  return previous.buffer != bind.buffer ||
+         previous.buffer_length != bind.buffer_length ||
+         previous.buffer_type != bind.buffer_type ||
+         previous.is_unsigned != bind.is_unsigned;
 }
 }
 
 /** Managed array of input `MYSQL_BIND`s.
  *
- * Has utility methods to bind values.
+ * Has utility methods to bind values. The generation of the array is
+ * incremented whenever a buffer, length or type changes, so that the binds
+ * are only given again to the client library when needed.
+ *
+ * Times are converted into a `MYSQL_TIME` stored in the array. There is one per
+ * slot, unless the array is given the number `NTIMES` of slots that may hold
+ * times: they must then be bound with the storage to use (see `bind`). Copies
+ * of the array point to their own storage.
  */
-template <std::size_t NBINDS>
+template <std::size_t NBINDS, std::size_t NTIMES = NBINDS>
 class InputBindArray
 {
 public:
-  constexpr explicit InputBindArray() noexcept : binds{}
+  static_assert(NTIMES <= NBINDS, "More time storage than slots");
+
+  constexpr explicit InputBindArray() noexcept
+    : binds{}, times{}, generation{0}
   {
     std::memset(&this->binds[0], 0, sizeof(MYSQL_BIND) * NBINDS);
   }
 
-  constexpr InputBindArray(InputBindArray const& b) = default;
-  constexpr InputBindArray(InputBindArray&& b) noexcept = default;
-  ~InputBindArray() noexcept
+  InputBindArray(InputBindArray const& b) noexcept
+    : binds{b.binds}, times{b.times}, generation{b.generation}
+  {
+    this->relocateFrom(b);
+  }
+  InputBindArray(InputBindArray&& b) noexcept
+    : InputBindArray{static_cast<InputBindArray const&>(b)}
   {
-    for (auto& bind : this->binds)
-      details::freeBindIfTime(bind);
   }
+  ~InputBindArray() noexcept = default;
 
-  constexpr InputBindArray& operator=(InputBindArray const& rhs) = default;
-  constexpr InputBindArray& operator=(InputBindArray&& rhs) noexcept = default;
+  InputBindArray& operator=(InputBindArray const& rhs) noexcept
+  {
+    this->binds = rhs.binds;
+    this->times = rhs.times;
+    this->generation = rhs.generation;
+    this->relocateFrom(rhs);
+    return *this;
+  }
+  InputBindArray& operator=(InputBindArray&& rhs) noexcept
+  {
+    return *this = static_cast<InputBindArray const&>(rhs);
+  }
 
   template <typename T>
   void bind(std::size_t idx, T const& value)
+  {
+    static_assert(NTIMES == NBINDS || !details::IsTime_v<T>,
+                  "The time storage of the slot must be given");
+    auto time_idx = idx;
+    this->bind(idx, value, time_idx);
+  }
+
+  /** Binds `value` to slot `idx`.
+   *
+   * Times are converted into the storage `time_idx`, which is then incremented
+   * so that consecutive time slots use consecutive storage. It is incremented
+   * for null optionals as well, so that a slot always uses the same storage.
+   */
+  template <typename T>
+  void bind(std::size_t idx, T const& value, std::size_t& time_idx)
+  {
+    auto const previous = this->binds[idx];
+    this->assign(idx, value, time_idx);
+    if constexpr (details::IsTime_v<T>)
+      ++time_idx;
+    if (details::bindChanged(previous, this->binds[idx]))
+      ++this->generation;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return this->binds.empty();
+  }
+
+  constexpr MYSQL_BIND const* data() const noexcept
+  {
+    return this->binds.data();
+  }
+
+  constexpr details::BindVersion version() const noexcept
+  {
+    return {this->binds.data(), this->generation};
+  }
+
+private:
+  /** Points the binds copied from `b` to the storage of this array.
+   */
+  void relocateFrom(InputBindArray const& b) noexcept
+  {
+    auto const* first = b.times.data();
+    auto const* last = first + NTIMES;
+    for (auto& mysql_bind : this->binds)
+    {
+      auto const* time = static_cast<MYSQL_TIME const*>(mysql_bind.buffer);
+      if (!std::less<>{}(time, first) && std::less<>{}(time, last))
+        mysql_bind.buffer = this->times.data() + (time - first);
+    }
+  }
+
+  template <typename T>
+  void assign(std::size_t idx, T const& value, std::size_t time_idx)
   {
     constexpr auto is_optional = meta::IsOptional_v<T>;
     using column_data_t = meta::LiftOptional_t<T>;
@@ -115,12 +255,14 @@ public:
         return value;
     }
     ();
-    details::freeBindIfTime(mysql_bind);
     static_assert(std::is_same_v<column_data_t, std::string> ||
                       std::is_same_v<column_data_t, char*> ||
                       std::is_same_v<column_data_t, char const*> ||
                       std::is_integral_v<column_data_t> ||
-                      std::is_same_v<column_data_t, std::tm>,
+                      std::is_floating_point_v<column_data_t> ||
+                      std::is_same_v<column_data_t, std::tm> ||
+                      meta::IsSysTime_v<column_data_t> ||
+                      meta::IsDuration_v<column_data_t>,
                   "Unknown type");
     if constexpr (std::is_same_v<column_data_t, std::string>)
     {
@@ -143,44 +285,65 @@ public:
       mysql_bind.buffer = const_cast<column_data_t*>(&attr);
       mysql_bind.buffer_length = sizeof(attr);
     }
+    else if constexpr (std::is_floating_point_v<column_data_t>)
+    {
+      mysql_bind.buffer_type =
+          details::getMySQLFloatingFieldType<column_data_t>();
+      mysql_bind.buffer = const_cast<column_data_t*>(&attr);
+      mysql_bind.buffer_length = sizeof(attr);
+    }
     else if constexpr (std::is_same_v<column_data_t, std::tm>)
     {
-      auto* time = new MYSQL_TIME{};
-      *time = details::toMySQLTime(attr);
+      // The buffer does not change, so rebinding a reference only converts it.
+      this->times[time_idx] = details::toMySQLTime(attr);
       mysql_bind.buffer_type = MYSQL_TYPE_DATETIME;
-      mysql_bind.buffer = time;
+      mysql_bind.buffer = &this->times[time_idx];
+      mysql_bind.buffer_length = sizeof(MYSQL_TIME);
+    }
+    else if constexpr (meta::IsSysTime_v<column_data_t> ||
+                       meta::IsDuration_v<column_data_t>)
+    {
+      this->times[time_idx] = details::toMySQLTime(attr);
+      mysql_bind.buffer_type =
+          details::getMySQLChronoFieldType<column_data_t>();
+      mysql_bind.buffer = &this->times[time_idx];
       mysql_bind.buffer_length = sizeof(MYSQL_TIME);
     }
   }
 
-  constexpr bool empty() const noexcept
-  {
-    return this->binds.empty();
-  }
-
-  constexpr MYSQL_BIND const* data() const noexcept
-  {
-    return this->binds.data();
-  }
-
-private:
   std::array<MYSQL_BIND, NBINDS> binds;
+  std::array<MYSQL_TIME, NTIMES> times;
+  std::size_t generation;
 };
 
-/** Managed array of input `MYSQL_BIND`s.
+/** Managed array of output `MYSQL_BIND`s.
  *
  * Has utility methods to bind values.
  *
- * `std::string`s are `resize`d and `char*` are `new`d.
- * The `finalize` method resizes to correct sizes once the query has been
- * executed (using the lengths).
+ * `std::string`s are `resize`d and `char*` are `new`d. The bound attributes
+ * are used as a scratch buffer for every fetched row. Their size defaults to
+ * the size of the `VARCHAR`, or 256, and can be overriden per slot with
+ * `setBufferSize` before binding. Longer values are truncated by
+ * `mysql_stmt_fetch`, and the remainder is fetched by `finalize`.
+ * The `finalize` method decodes a fetched value into another attribute, using
+ * the lengths so that strings only take the size of the data.
+ *
+ * As for `InputBindArray`, the generation of the array is incremented whenever
+ * a buffer, length or type changes, and `std::tm`s are fetched into a
+ * `MYSQL_TIME` stored in the array.
  */
 template <std::size_t NBINDS>
 class OutputBindArray
 {
 public:
   constexpr explicit OutputBindArray() noexcept
-    : binds(), lengths(), is_null(), error()
+    : binds(),
+      times(),
+      lengths(),
+      is_null(),
+      error(),
+      buffer_sizes(),
+      generation(0)
   {
     std::memset(&this->binds[0], 0, sizeof(MYSQL_BIND) * NBINDS);
     for (auto i = std::size_t{0}; i < NBINDS; ++i)
@@ -191,137 +354,160 @@ public:
     }
   }
 
-  constexpr OutputBindArray(OutputBindArray const& b) = default;
-  constexpr OutputBindArray(OutputBindArray&& b) noexcept = default;
-  ~OutputBindArray() noexcept
+  OutputBindArray(OutputBindArray const& b) noexcept
+    : binds(b.binds),
+      times(b.times),
+      lengths(b.lengths),
+      is_null(b.is_null),
+      error(b.error),
+      buffer_sizes(b.buffer_sizes),
+      generation(b.generation)
   {
-    for (auto& bind : this->binds)
-      details::freeBindIfTime(bind);
+    this->relocateFrom(b);
   }
+  OutputBindArray(OutputBindArray&& b) noexcept
+    : OutputBindArray{static_cast<OutputBindArray const&>(b)}
+  {
+  }
+  ~OutputBindArray() noexcept = default;
 
-  constexpr OutputBindArray& operator=(OutputBindArray const& rhs) = default;
-  constexpr OutputBindArray& operator=(OutputBindArray&& rhs) noexcept =
-      default;
+  OutputBindArray& operator=(OutputBindArray const& rhs) noexcept
+  {
+    this->binds = rhs.binds;
+    this->times = rhs.times;
+    this->lengths = rhs.lengths;
+    this->is_null = rhs.is_null;
+    this->error = rhs.error;
+    this->buffer_sizes = rhs.buffer_sizes;
+    this->generation = rhs.generation;
+    this->relocateFrom(rhs);
+    return *this;
+  }
+  OutputBindArray& operator=(OutputBindArray&& rhs) noexcept
+  {
+    return *this = static_cast<OutputBindArray const&>(rhs);
+  }
 
   template <std::size_t varchar_size, typename T>
   void bind(std::size_t idx, T& value)
+  {
+    auto const previous = this->binds[idx];
+    this->assign<varchar_size>(idx, value);
+    if (details::bindChanged(previous, this->binds[idx]))
+      ++this->generation;
+  }
+
+  /** Decodes the fetched value of a slot into `value`.
+   *
+   * `bound` is the attribute that was given to `bind` for this slot. Strings
+   * are copied at their exact length, so that `value` does not inherit the
+   * capacity of the scratch buffer. If a string was truncated, `value` is
+   * grown to the length of the data and the remainder is fetched from `stmt`.
+   * `char*`s are `new`d. The caller owns them.
+   */
+  template <typename T>
+  void finalize(MYSQL_STMT& stmt, std::size_t idx, T const& bound, T& value)
   {
     using attribute_t = T;
     constexpr auto is_optional = meta::IsOptional_v<attribute_t>;
     using column_data_t = std::conditional_t<is_optional,
                                              meta::LiftOptional_t<attribute_t>,
                                              attribute_t>;
-    auto& attr = [&]() -> auto&
-    {
-      auto& field = value;
-      if constexpr (is_optional)
-      {
-        if (!field)
-          field.emplace();
-        return *field;
-      }
-      else
-        return field;
-    }
-    ();
-    auto& mysql_bind = this->binds[idx];
-    details::freeBindIfTime(mysql_bind);
     static_assert(std::is_same_v<column_data_t, std::string> ||
                       std::is_same_v<column_data_t, char*> ||
                       std::is_integral_v<column_data_t> ||
-                      std::is_same_v<column_data_t, std::tm>,
+                      std::is_floating_point_v<column_data_t> ||
+                      std::is_same_v<column_data_t, std::tm> ||
+                      meta::IsSysTime_v<column_data_t> ||
+                      meta::IsDuration_v<column_data_t>,
                   "Unknown type");
-    if constexpr (std::is_same_v<column_data_t, std::string>)
-    {
-      // XXX(ethiraric): Find a way to correctly allocate it.
-      constexpr auto buffer_size = varchar_size > 0 ? varchar_size : 65536;
-      attr.resize(buffer_size);
-      mysql_bind.buffer_type = MYSQL_TYPE_STRING;
-      mysql_bind.buffer = &attr[0];
-      mysql_bind.buffer_length = buffer_size;
-    }
-    else if constexpr (std::is_same_v<column_data_t, char*>)
-    {
-      // XXX(ethiraric): Find a way to correctly allocate it.
-      constexpr auto buffer_size = varchar_size > 0 ? varchar_size : 65536;
-      attr = new char[buffer_size];
-      mysql_bind.buffer_type = MYSQL_TYPE_STRING;
-      mysql_bind.buffer = attr;
-      mysql_bind.buffer_length = buffer_size;
-    }
-    else if constexpr (std::is_integral_v<column_data_t>)
-    {
-      mysql_bind.is_unsigned = std::is_unsigned_v<column_data_t>;
-      mysql_bind.buffer_type =
-          details::getMySQLIntegralFieldType<column_data_t>();
-      mysql_bind.buffer = &attr;
-      mysql_bind.buffer_length = sizeof(attr);
-    }
-    else if constexpr (std::is_same_v<column_data_t, std::tm>)
+
+    if constexpr (is_optional)
     {
-      auto* time = new MYSQL_TIME{};
-      mysql_bind.buffer_type = MYSQL_TYPE_DATETIME;
-      mysql_bind.buffer = time;
-      mysql_bind.buffer_length = sizeof(MYSQL_TIME);
+      if (this->isNull(idx))
+      {
+        value.reset();
+        return;
+      }
     }
-  }
 
-  template <typename T>
-  void finalize(std::size_t idx, T& value)
-  {
-    using attribute_t = T;
-    constexpr auto is_optional = meta::IsOptional_v<attribute_t>;
-    using column_data_t = std::conditional_t<is_optional,
-                                             meta::LiftOptional_t<attribute_t>,
-                                             attribute_t>;
     auto& attr = [&]() -> auto&
     {
       auto& field = value;
       if constexpr (is_optional)
+      {
+        if (!field)
+          field.emplace();
         return *field;
+      }
       else
         return field;
     }
     ();
-    static_assert(std::is_same_v<column_data_t, std::string> ||
-                      std::is_same_v<column_data_t, char*> ||
-                      std::is_integral_v<column_data_t> ||
-                      std::is_same_v<column_data_t, std::tm>,
-                  "Unknown type");
-
-    if constexpr (is_optional)
+    // `bind` engaged optionals, so `bound` always holds a value.
+    auto const& bound_attr = [&]() -> auto const&
     {
-      if (this->isNull(idx))
-      {
-        value.reset();
-        return;
-      }
+      if constexpr (is_optional)
+        return *bound;
+      else
+        return bound;
     }
+    ();
 
     if constexpr (std::is_same_v<column_data_t, std::string>)
     {
       if (this->isNull(idx))
         attr.clear();
+      else if (!this->hasErrored(idx))
+        attr.assign(bound_attr.data(), this->length(idx));
       else
+      {
         attr.resize(this->length(idx));
+        this->fetchTruncated(stmt, idx, bound_attr.data(), &attr[0]);
+      }
     }
-    else if constexpr (std::is_same_v<column_data_t, char*> ||
-                       std::is_same_v<column_data_t, char const*>)
+    else if constexpr (std::is_same_v<column_data_t, char*>)
     {
       auto const length = this->length(idx);
       auto* newtab = new char[length + 1];
-      std::memcpy(newtab, attr, length);
+      if (!this->hasErrored(idx))
+        std::memcpy(newtab, bound_attr, length);
+      else
+        this->fetchTruncated(stmt, idx, bound_attr, newtab);
       newtab[length] = '\0';
-      delete[] attr;
       attr = newtab;
     }
-    else if constexpr (std::is_same_v<column_data_t, std::tm>)
+    else
     {
-      attr = details::fromMySQLTime(
-          *reinterpret_cast<MYSQL_TIME*>(this->binds[idx].buffer));
+      if (this->hasErrored(idx))
+        throw MySQLException("Value out of range for column " +
+                             std::to_string(idx));
+      if constexpr (std::is_same_v<column_data_t, std::tm>)
+        attr = details::fromMySQLTime(this->times[idx]);
+      else if constexpr (meta::IsSysTime_v<column_data_t> ||
+                         meta::IsDuration_v<column_data_t>)
+        attr = details::fromMySQLTimeAs<column_data_t>(this->times[idx]);
+      else
+        attr = bound_attr;
     }
+  }
+
+  /** Copies the fetched value of a text slot into `dest`.
+   *
+   * `head` is the buffer bound to the slot. `dest` must hold `length(idx)`
+   * bytes. Truncated values are fetched again in full.
+   */
+  void copyText(MYSQL_STMT& stmt,
+                std::size_t idx,
+                char const* head,
+                char* dest)
+  {
+    if (this->isNull(idx))
+      return;
+    if (!this->hasErrored(idx))
+      std::memcpy(dest, head, this->length(idx));
     else
-      (void)(idx);
+      this->fetchTruncated(stmt, idx, head, dest);
   }
 
   constexpr bool empty() const noexcept
@@ -339,6 +525,37 @@ public:
     return this->lengths[idx];
   }
 
+  constexpr details::BindVersion version() const noexcept
+  {
+    return {this->binds.data(), this->generation};
+  }
+
+  /** Returns the total length of the non-null values of the fetched row.
+   */
+  constexpr unsigned long long rowLength() const noexcept
+  {
+    auto ret = 0ull;
+    for (auto i = std::size_t{0}; i < NBINDS; ++i)
+      if (!this->is_null[i])
+        ret += this->lengths[i];
+    return ret;
+  }
+
+  /** Sets the size of the buffer of a text slot for the next `bind`.
+   *
+   * A size of 0 restores the default.
+   */
+  constexpr void setBufferSize(std::size_t idx, unsigned long size) noexcept
+  {
+    this->buffer_sizes[idx] = size;
+  }
+
+  constexpr void resetBufferSizes() noexcept
+  {
+    for (auto& size : this->buffer_sizes)
+      size = 0;
+  }
+
   constexpr bool isNull(std::size_t idx) const noexcept
   {
     return this->is_null[idx];
@@ -350,10 +567,149 @@ public:
   }
 
 private:
+  /** Points the binds copied from `b` to the storage of this array.
+   *
+   * Text buffers are the bound attributes, and are left as they are.
+   */
+  void relocateFrom(OutputBindArray const& b) noexcept
+  {
+    for (auto i = std::size_t{0}; i < NBINDS; ++i)
+    {
+      if (this->binds[i].buffer == &b.times[i])
+        this->binds[i].buffer = &this->times[i];
+      this->binds[i].length = &this->lengths[i];
+      this->binds[i].is_null = &this->is_null[i];
+      this->binds[i].error = &this->error[i];
+    }
+  }
+
+  template <std::size_t varchar_size, typename T>
+  void assign(std::size_t idx, T& value)
+  {
+    using attribute_t = T;
+    constexpr auto is_optional = meta::IsOptional_v<attribute_t>;
+    using column_data_t = std::conditional_t<is_optional,
+                                             meta::LiftOptional_t<attribute_t>,
+                                             attribute_t>;
+    auto& attr = [&]() -> auto&
+    {
+      auto& field = value;
+      if constexpr (is_optional)
+      {
+        if (!field)
+          field.emplace();
+        return *field;
+      }
+      else
+        return field;
+    }
+    ();
+    auto& mysql_bind = this->binds[idx];
+    static_assert(std::is_same_v<column_data_t, std::string> ||
+                      std::is_same_v<column_data_t, char*> ||
+                      std::is_integral_v<column_data_t> ||
+                      std::is_floating_point_v<column_data_t> ||
+                      std::is_same_v<column_data_t, std::tm> ||
+                      meta::IsSysTime_v<column_data_t> ||
+                      meta::IsDuration_v<column_data_t>,
+                  "Unknown type");
+    if constexpr (std::is_same_v<column_data_t, std::string>)
+    {
+      auto const buffer_size = this->bufferSize<varchar_size>(idx);
+      attr.resize(buffer_size);
+      mysql_bind.buffer_type = MYSQL_TYPE_STRING;
+      mysql_bind.buffer = &attr[0];
+      mysql_bind.buffer_length = buffer_size;
+    }
+    else if constexpr (std::is_same_v<column_data_t, char*>)
+    {
+      auto const buffer_size = this->bufferSize<varchar_size>(idx);
+      // Binding the same attribute again (e.g.: in buffered mode) reuses its
+      // buffer, unless it is too small.
+      auto const rebound = mysql_bind.buffer && mysql_bind.buffer == attr;
+      if (!rebound || mysql_bind.buffer_length < buffer_size)
+      {
+        if (rebound)
+          delete[] attr;
+        attr = new char[buffer_size];
+      }
+      mysql_bind.buffer_type = MYSQL_TYPE_STRING;
+      mysql_bind.buffer = attr;
+      mysql_bind.buffer_length = buffer_size;
+    }
+    else if constexpr (std::is_integral_v<column_data_t>)
+    {
+      mysql_bind.is_unsigned = std::is_unsigned_v<column_data_t>;
+      mysql_bind.buffer_type =
+          details::getMySQLIntegralFieldType<column_data_t>();
+      mysql_bind.buffer = &attr;
+      mysql_bind.buffer_length = sizeof(attr);
+    }
+    else if constexpr (std::is_floating_point_v<column_data_t>)
+    {
+      mysql_bind.buffer_type =
+          details::getMySQLFloatingFieldType<column_data_t>();
+      mysql_bind.buffer = &attr;
+      mysql_bind.buffer_length = sizeof(attr);
+    }
+    else if constexpr (std::is_same_v<column_data_t, std::tm>)
+    {
+      mysql_bind.buffer_type = MYSQL_TYPE_DATETIME;
+      mysql_bind.buffer = &this->times[idx];
+      mysql_bind.buffer_length = sizeof(MYSQL_TIME);
+    }
+    else if constexpr (meta::IsSysTime_v<column_data_t> ||
+                       meta::IsDuration_v<column_data_t>)
+    {
+      mysql_bind.buffer_type =
+          details::getMySQLChronoFieldType<column_data_t>();
+      mysql_bind.buffer = &this->times[idx];
+      mysql_bind.buffer_length = sizeof(MYSQL_TIME);
+    }
+  }
+
+  template <std::size_t varchar_size>
+  constexpr unsigned long bufferSize(std::size_t idx) const noexcept
+  {
+    // Small enough to be cheap for most values. Longer ones are fetched in a
+    // second pass.
+    constexpr auto default_size = varchar_size > 0 ? varchar_size : 256;
+    return this->buffer_sizes[idx] > 0 ? this->buffer_sizes[idx]
+                                       : default_size;
+  }
+
+  /** Fetches a truncated text value into `dest`.
+   *
+   * `head` is the scratch buffer, which holds the beginning of the value.
+   * `dest` must hold `length(idx)` bytes.
+   */
+  void fetchTruncated(MYSQL_STMT& stmt,
+                      std::size_t idx,
+                      char const* head,
+                      char* dest)
+  {
+    auto const offset = this->binds[idx].buffer_length;
+    std::memcpy(dest, head, offset);
+    auto bind = this->binds[idx];
+    // Let the client library use the bind's own fields.
+    bind.length = nullptr;
+    bind.is_null = nullptr;
+    bind.error = nullptr;
+    bind.buffer = dest + offset;
+    bind.buffer_length = this->length(idx) - offset;
+    if (mysql_stmt_fetch_column(
+            &stmt, &bind, static_cast<unsigned int>(idx), offset))
+      throw MySQLException("Failed to fetch column: " +
+                           std::string{mysql_stmt_error(&stmt)});
+  }
+
   std::array<MYSQL_BIND, NBINDS> binds;
+  std::array<MYSQL_TIME, NBINDS> times;
   std::array<unsigned long, NBINDS> lengths;
   std::array<my_bool, NBINDS> is_null;
   std::array<my_bool, NBINDS> error;
+  std::array<unsigned long, NBINDS> buffer_sizes;
+  std::size_t generation;
 };
 }
 
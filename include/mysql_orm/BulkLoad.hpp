@@ -0,0 +1,292 @@
+#ifndef MYSQL_ORM_BULKLOAD_HPP_
+#define MYSQL_ORM_BULKLOAD_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <mysql/errmsg.h>
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Chrono.hpp>
+#include <mysql_orm/Exception.hh>
+#include <mysql_orm/meta/IsChrono.hpp>
+#include <mysql_orm/meta/IsOptional.hpp>
+#include <mysql_orm/meta/LiftOptional.hpp>
+
+namespace mysql_orm
+{
+namespace details
+{
+/** Appends a text value, escaped for `LOAD DATA`'s default format.
+ */
+inline void appendLoadDataEscaped(std::string& out,
+                                  char const* data,
+                                  std::size_t size)
+{
+  for (auto i = std::size_t{0}; i < size; ++i)
+  {
+    switch (data[i])
+    {
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\0':
+      out += "\\0";
+      break;
+    default:
+      out += data[i];
+    }
+  }
+}
+
+/** Appends a field in `LOAD DATA`'s default format.
+ *
+ * `NULL`s are written as `\N`.
+ */
+template <typename T>
+void appendLoadDataField(std::string& out, T const& value)
+{
+  using column_data_t = meta::LiftOptional_t<T>;
+  static_assert(std::is_same_v<column_data_t, std::string> ||
+                    std::is_same_v<column_data_t, char*> ||
+                    std::is_same_v<column_data_t, char const*> ||
+                    std::is_integral_v<column_data_t> ||
+                    std::is_floating_point_v<column_data_t> ||
+                    std::is_same_v<column_data_t, std::tm> ||
+                    meta::IsSysTime_v<column_data_t> ||
+                    meta::IsDuration_v<column_data_t>,
+                "Unknown type");
+
+  if constexpr (meta::IsOptional_v<T>)
+  {
+    if (!value)
+      out += "\\N";
+    else
+      appendLoadDataField(out, *value);
+  }
+  else if constexpr (std::is_same_v<T, std::string>)
+    appendLoadDataEscaped(out, value.data(), value.size());
+  else if constexpr (std::is_same_v<T, char*> ||
+                     std::is_same_v<T, char const*>)
+  {
+    if (!value)
+      out += "\\N";
+    else
+      appendLoadDataEscaped(out, value, std::strlen(value));
+  }
+  else if constexpr (std::is_same_v<T, bool>)
+    out += value ? '1' : '0';
+  else if constexpr (std::is_integral_v<T>)
+    out += std::to_string(value);
+  else if constexpr (std::is_floating_point_v<T>)
+  {
+    // `max_digits10` significant digits read back as the same value.
+    char buffer[32];
+    auto const len = std::snprintf(buffer,
+                                   sizeof(buffer),
+                                   "%.*g",
+                                   std::numeric_limits<T>::max_digits10,
+                                   static_cast<double>(value));
+    out.append(buffer, static_cast<std::size_t>(len));
+  }
+  else if constexpr (std::is_same_v<T, std::tm>)
+  {
+    char buffer[32];
+    auto const len = std::snprintf(buffer,
+                                   sizeof(buffer),
+                                   "%04d-%02d-%02d %02d:%02d:%02d",
+                                   value.tm_year + 1900,
+                                   value.tm_mon + 1,
+                                   value.tm_mday,
+                                   value.tm_hour,
+                                   value.tm_min,
+                                   value.tm_sec);
+    out.append(buffer, static_cast<std::size_t>(len));
+  }
+  else if constexpr (meta::IsSysTime_v<T>)
+  {
+    auto const time = details::toMySQLTime(value);
+    char buffer[40];
+    auto const len = std::snprintf(buffer,
+                                   sizeof(buffer),
+                                   "%04u-%02u-%02u %02u:%02u:%02u.%06lu",
+                                   time.year,
+                                   time.month,
+                                   time.day,
+                                   time.hour,
+                                   time.minute,
+                                   time.second,
+                                   time.second_part);
+    out.append(buffer, static_cast<std::size_t>(len));
+  }
+  else if constexpr (meta::IsDuration_v<T>)
+  {
+    auto const time = details::toMySQLTime(value);
+    char buffer[32];
+    auto const len = std::snprintf(buffer,
+                                   sizeof(buffer),
+                                   "%s%02u:%02u:%02u.%06lu",
+                                   time.neg ? "-" : "",
+                                   time.day * 24 + time.hour,
+                                   time.minute,
+                                   time.second,
+                                   time.second_part);
+    out.append(buffer, static_cast<std::size_t>(len));
+  }
+}
+}
+
+/** Loads a range of models with `LOAD DATA LOCAL INFILE`.
+ *
+ * Models are serialized to the tab-separated format `LOAD DATA` expects and
+ * streamed to the server through a local infile handler, a few rows at a
+ * time. No file is written.
+ *
+ * The connection must be made with `local_infile` set (see
+ * `ConnectionOptions`), and the server must allow it. Text is sent as
+ * `utf8mb4`.
+ *
+ * `operator()` executes the query and returns the number of loaded rows.
+ */
+template <typename Table, typename Iterator, auto... Attrs>
+class BulkLoad
+{
+public:
+  using model_type = typename Table::model_type;
+  using table_type = Table;
+
+  BulkLoad(MYSQL& mysql, Table const& t, Iterator first, Iterator last)
+    : mysql_handle{&mysql},
+      table{&t},
+      current{first},
+      end{last},
+      buffer{},
+      pos{0},
+      error_message{}
+  {
+  }
+  BulkLoad(BulkLoad const& b) = delete;
+  BulkLoad(BulkLoad&& b) = delete;
+  ~BulkLoad() noexcept = default;
+
+  BulkLoad& operator=(BulkLoad const& rhs) = delete;
+  BulkLoad& operator=(BulkLoad&& rhs) = delete;
+
+  std::size_t operator()()
+  {
+    auto const query = this->buildquery();
+    mysql_set_local_infile_handler(this->mysql_handle,
+                                   &BulkLoad::infileInit,
+                                   &BulkLoad::infileRead,
+                                   &BulkLoad::infileEnd,
+                                   &BulkLoad::infileError,
+                                   this);
+    auto const failed =
+        mysql_real_query(this->mysql_handle, query.c_str(), query.size());
+    mysql_set_local_infile_default(this->mysql_handle);
+    if (failed)
+      throw MySQLQueryException(mysql_errno(this->mysql_handle),
+                                mysql_error(this->mysql_handle));
+    return mysql_affected_rows(this->mysql_handle);
+  }
+
+  constexpr auto buildquery() const
+  {
+    return this->table->template loadDataCS<Attrs...>();
+  }
+
+private:
+  static int infileInit(void** ptr, char const*, void* userdata) noexcept
+  {
+    *ptr = userdata;
+    return 0;
+  }
+
+  static int infileRead(void* ptr, char* buf, unsigned int buf_len) noexcept
+  {
+    auto& self = *static_cast<BulkLoad*>(ptr);
+    try
+    {
+      self.fill(buf_len);
+    }
+    catch (std::exception const& e)
+    {
+      self.error_message = e.what();
+      return -1;
+    }
+    auto const len = std::min<std::size_t>(buf_len, self.available());
+    std::memcpy(buf, self.buffer.data() + self.pos, len);
+    self.pos += len;
+    return static_cast<int>(len);
+  }
+
+  static void infileEnd(void*) noexcept
+  {
+  }
+
+  static int infileError(void* ptr, char* msg, unsigned int msg_len) noexcept
+  {
+    auto& self = *static_cast<BulkLoad*>(ptr);
+    if (msg_len > 0)
+    {
+      auto const len =
+          std::min<std::size_t>(msg_len - 1, self.error_message.size());
+      std::memcpy(msg, self.error_message.data(), len);
+      msg[len] = '\0';
+    }
+    return CR_UNKNOWN_ERROR;
+  }
+
+  std::size_t available() const noexcept
+  {
+    return this->buffer.size() - this->pos;
+  }
+
+  /** Serializes rows until at least `n` bytes are ready, or no row is left.
+   */
+  void fill(std::size_t n)
+  {
+    if (this->available() >= n)
+      return;
+    this->buffer.erase(0, this->pos);
+    this->pos = 0;
+    for (; this->buffer.size() < n && this->current != this->end;
+         ++this->current)
+    {
+      auto const& model = *this->current;
+      ((details::appendLoadDataField(this->buffer, model.*Attrs),
+        this->buffer += '\t'),
+       ...);
+      // Replace the last separator.
+      this->buffer.back() = '\n';
+    }
+  }
+
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Table const* table;
+  Iterator current;
+  Iterator end;
+  // Serialized rows, of which the first `pos` bytes have been sent.
+  std::string buffer;
+  std::size_t pos;
+  std::string error_message;
+};
+}
+
+#endif /* !MYSQL_ORM_BULKLOAD_HPP_ */
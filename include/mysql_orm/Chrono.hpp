@@ -0,0 +1,206 @@
+#ifndef MYSQL_ORM_CHRONO_HPP_
+#define MYSQL_ORM_CHRONO_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/meta/IsChrono.hpp>
+
+namespace mysql_orm
+{
+/** Time types of `std::chrono`, as named in C++20.
+ *
+ * Columns of these types are mapped as:
+ *   - `sys_days` (and coarser time points): `DATE`.
+ *   - `sys_seconds` (and coarser time points): `DATETIME`.
+ *   - Finer time points: `DATETIME(6)`.
+ *   - Durations of seconds (or coarser): `TIME`.
+ *   - Finer durations: `TIME(6)`.
+ *
+ * Time points are in UTC, and durations may be negative. Values finer than
+ * microseconds are truncated towards the past.
+ */
+using days = std::chrono::duration<int, std::ratio<86400>>;
+
+template <typename Duration>
+using sys_time = std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+using sys_days = sys_time<days>;
+using sys_seconds = sys_time<std::chrono::seconds>;
+
+namespace details
+{
+/** Returns true if values of `Duration` hold no fraction of `Period`.
+ */
+template <typename Duration, typename Period>
+inline constexpr bool is_coarser_than_v =
+    std::is_integral_v<typename Duration::rep> &&
+    std::ratio_greater_equal_v<typename Duration::period, Period>;
+
+/** Metafunction returning true if `T` is a time point of whole days.
+ *
+ * Other types are not looked into, so that checking them compiles.
+ */
+template <typename T>
+struct IsDate : std::false_type
+{
+};
+
+template <typename Duration>
+struct IsDate<sys_time<Duration>>
+  : std::bool_constant<is_coarser_than_v<Duration, typename days::period>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_date_v = IsDate<T>::value;
+
+/** Metafunction returning the duration of a time point, or the duration
+ * itself.
+ */
+template <typename T>
+struct ChronoDuration
+{
+  using type = T;
+};
+
+template <typename Duration>
+struct ChronoDuration<sys_time<Duration>>
+{
+  using type = Duration;
+};
+
+/** Returns true if `T` maps to a column with microseconds.
+ */
+template <typename T>
+inline constexpr bool has_fractional_seconds_v =
+    !is_coarser_than_v<typename ChronoDuration<T>::type, std::ratio<1>>;
+
+inline constexpr std::int64_t microseconds_per_day{86400 * 1000000ll};
+
+/** Returns the number of days from 1970-01-01 to the given date.
+ *
+ * See http://howardhinnant.github.io/date_algorithms.html.
+ */
+constexpr std::int64_t daysFromCivil(std::int64_t y,
+                                     unsigned m,
+                                     unsigned d) noexcept
+{
+  y -= m <= 2;
+  auto const era = (y >= 0 ? y : y - 399) / 400;
+  auto const yoe = static_cast<unsigned>(y - era * 400);
+  auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+/** Sets the date of `time` from a number of days since 1970-01-01.
+ */
+constexpr void civilFromDays(std::int64_t z, MYSQL_TIME& time) noexcept
+{
+  z += 719468;
+  auto const era = (z >= 0 ? z : z - 146096) / 146097;
+  auto const doe = static_cast<unsigned>(z - era * 146097);
+  auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  auto const mp = (5 * doy + 2) / 153;
+  time.day = doy - (153 * mp + 2) / 5 + 1;
+  time.month = mp < 10 ? mp + 3 : mp - 9;
+  time.year = static_cast<unsigned>(static_cast<std::int64_t>(yoe) +
+                                    era * 400 + (time.month <= 2));
+}
+
+/** Sets the time of day of `time` from a number of microseconds.
+ */
+constexpr void setTimeOfDay(std::int64_t us, MYSQL_TIME& time) noexcept
+{
+  time.second_part = static_cast<unsigned long>(us % 1000000);
+  us /= 1000000;
+  time.second = static_cast<unsigned>(us % 60);
+  us /= 60;
+  time.minute = static_cast<unsigned>(us % 60);
+  time.hour = static_cast<unsigned>(us / 60);
+}
+
+constexpr std::int64_t getTimeOfDay(MYSQL_TIME const& time) noexcept
+{
+  return ((std::int64_t{time.hour} * 60 + time.minute) * 60 + time.second) *
+             1000000 +
+         static_cast<std::int64_t>(time.second_part);
+}
+
+template <typename Duration>
+MYSQL_TIME toMySQLTime(sys_time<Duration> const& tp) noexcept
+{
+  auto ret = MYSQL_TIME{};
+  auto const us = std::chrono::floor<std::chrono::microseconds>(tp)
+                      .time_since_epoch()
+                      .count();
+  // Floored, so that the time of day is positive.
+  auto const day = (us >= 0 ? us : us - microseconds_per_day + 1) /
+                   microseconds_per_day;
+  civilFromDays(day, ret);
+  setTimeOfDay(us - day * microseconds_per_day, ret);
+  ret.time_type = is_date_v<sys_time<Duration>> ? MYSQL_TIMESTAMP_DATE
+                                                 : MYSQL_TIMESTAMP_DATETIME;
+  return ret;
+}
+
+template <typename Rep, typename Period>
+MYSQL_TIME toMySQLTime(std::chrono::duration<Rep, Period> const& d) noexcept
+{
+  auto ret = MYSQL_TIME{};
+  auto const us = std::chrono::floor<std::chrono::microseconds>(d).count();
+  ret.neg = us < 0;
+  setTimeOfDay(us < 0 ? -us : us, ret);
+  // The client library sends `hour` as a single byte: whole days go in `day`.
+  ret.day = ret.hour / 24;
+  ret.hour %= 24;
+  ret.time_type = MYSQL_TIMESTAMP_TIME;
+  return ret;
+}
+
+/** Converts a `MYSQL_TIME` into a time point or a duration.
+ */
+template <typename T>
+T fromMySQLTimeAs(MYSQL_TIME const& time) noexcept
+{
+  if constexpr (meta::IsSysTime_v<T>)
+  {
+    auto const us =
+        daysFromCivil(time.year, time.month, time.day) * microseconds_per_day +
+        getTimeOfDay(time);
+    return T{std::chrono::duration_cast<typename T::duration>(
+        std::chrono::microseconds{us})};
+  }
+  else
+  {
+    static_assert(meta::IsDuration_v<T>, "Unknown time type");
+    // TIME values may carry whole days in `day`.
+    auto const us =
+        std::int64_t{time.day} * microseconds_per_day + getTimeOfDay(time);
+    return std::chrono::duration_cast<T>(
+        std::chrono::microseconds{time.neg ? -us : us});
+  }
+}
+
+/** Returns the MySQL type of a time point or duration.
+ */
+template <typename T>
+constexpr enum_field_types getMySQLChronoFieldType() noexcept
+{
+  if constexpr (meta::IsDuration_v<T>)
+    return MYSQL_TYPE_TIME;
+  else if constexpr (is_date_v<T>)
+    return MYSQL_TYPE_DATE;
+  else
+    return MYSQL_TYPE_DATETIME;
+}
+}
+}
+
+#endif /* !MYSQL_ORM_CHRONO_HPP_ */
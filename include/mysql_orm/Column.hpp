@@ -10,8 +10,10 @@
 #include <CompileString/CompileString.hpp>
 #include <CompileString/ToString.hpp>
 
+#include <mysql_orm/Chrono.hpp>
 #include <mysql_orm/ColumnConstraints.hpp>
 #include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/IsChrono.hpp>
 #include <mysql_orm/meta/IsOptional.hpp>
 #include <mysql_orm/meta/LiftOptional.hpp>
 
@@ -51,8 +53,28 @@ constexpr auto getFieldSQLType()
     else if constexpr (std::is_same_v<Field, uint64_t>)
       return compile_string::CompileString{"BIGINT UNSIGNED"};
   }
+  else if constexpr (std::is_same_v<Field, float>)
+    return compile_string::CompileString{"FLOAT"};
+  else if constexpr (std::is_same_v<Field, double>)
+    return compile_string::CompileString{"DOUBLE"};
   else if constexpr (std::is_same_v<Field, std::tm>)
     return compile_string::CompileString{"DATETIME"};
+  else if constexpr (details::is_date_v<Field>)
+    return compile_string::CompileString{"DATE"};
+  else if constexpr (meta::IsSysTime_v<Field>)
+  {
+    if constexpr (details::has_fractional_seconds_v<Field>)
+      return compile_string::CompileString{"DATETIME(6)"};
+    else
+      return compile_string::CompileString{"DATETIME"};
+  }
+  else if constexpr (meta::IsDuration_v<Field>)
+  {
+    if constexpr (details::has_fractional_seconds_v<Field>)
+      return compile_string::CompileString{"TIME(6)"};
+    else
+      return compile_string::CompileString{"TIME"};
+  }
 }
 
 /** A Column in a table.
@@ -0,0 +1,355 @@
+#ifndef MYSQL_ORM_COLUMNARRESULT_HPP_
+#define MYSQL_ORM_COLUMNARRESULT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/TypeValEquals.hpp>
+
+namespace mysql_orm
+{
+/** Values of a text column, stored end to end in a single buffer.
+ *
+ * Value `i` spans `[getOffsets()[i], getOffsets()[i + 1])` in `getBytes()`.
+ */
+class StringColumn
+{
+public:
+  StringColumn() : offsets{0}, bytes{}
+  {
+  }
+
+  std::size_t size() const noexcept
+  {
+    return this->offsets.size() - 1;
+  }
+
+  bool empty() const noexcept
+  {
+    return this->size() == 0;
+  }
+
+  std::string_view operator[](std::size_t idx) const noexcept
+  {
+    return std::string_view{this->bytes}.substr(
+        this->offsets[idx], this->offsets[idx + 1] - this->offsets[idx]);
+  }
+
+  std::vector<std::size_t> const& getOffsets() const noexcept
+  {
+    return this->offsets;
+  }
+
+  std::string const& getBytes() const noexcept
+  {
+    return this->bytes;
+  }
+
+  void reserve(std::size_t nb_values)
+  {
+    this->offsets.reserve(nb_values + 1);
+  }
+
+  void push_back(std::string_view value)
+  {
+    std::memcpy(this->extend(value.size()), value.data(), value.size());
+  }
+
+  /** Appends a value of `length` bytes, and returns where to write them.
+   */
+  char* extend(std::size_t length)
+  {
+    auto const offset = this->bytes.size();
+    this->bytes.resize(offset + length);
+    this->offsets.push_back(offset + length);
+    return this->bytes.data() + offset;
+  }
+
+private:
+  std::vector<std::size_t> offsets;
+  std::string bytes;
+};
+
+/** Values of a nullable column, with a validity bitmap.
+ *
+ * Bit `i % 64` of word `i / 64` of the bitmap is set if value `i` is not
+ * `NULL`. Null values hold a default value in `getValues()`, so that values
+ * stay aligned with rows.
+ */
+template <typename Values>
+class NullableColumn
+{
+public:
+  NullableColumn() : values{}, validity{}, nb_nulls{0}
+  {
+  }
+
+  std::size_t size() const noexcept
+  {
+    return this->values.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return this->values.empty();
+  }
+
+  bool isValid(std::size_t idx) const noexcept
+  {
+    return (this->validity[idx / 64] >> (idx % 64)) & 1u;
+  }
+
+  std::size_t nullCount() const noexcept
+  {
+    return this->nb_nulls;
+  }
+
+  Values const& getValues() const noexcept
+  {
+    return this->values;
+  }
+
+  std::vector<std::uint64_t> const& getValidity() const noexcept
+  {
+    return this->validity;
+  }
+
+  void reserve(std::size_t nb_values)
+  {
+    this->values.reserve(nb_values);
+    this->validity.reserve((nb_values + 63) / 64);
+  }
+
+  /** Appends a validity bit, and returns the values to append to.
+   */
+  Values& extend(bool valid)
+  {
+    auto const idx = this->values.size();
+    if (idx % 64 == 0)
+      this->validity.push_back(0);
+    if (valid)
+      this->validity.back() |= std::uint64_t{1} << (idx % 64);
+    else
+      ++this->nb_nulls;
+    return this->values;
+  }
+
+private:
+  Values values;
+  std::vector<std::uint64_t> validity;
+  std::size_t nb_nulls;
+};
+
+namespace details
+{
+/** Metafunction returning the storage of a column of attributes of type `T`.
+ *
+ *   - Text (`std::string` and `char*`): `StringColumn`.
+ *   - `std::optional<U>`: `NullableColumn` of the storage of `U`.
+ *   - `bool`: `std::vector<std::uint8_t>`, since `std::vector<bool>` is
+ *     neither contiguous nor addressable.
+ *   - Others: `std::vector<T>`.
+ */
+template <typename T>
+struct ColumnStorage
+{
+  using type = std::vector<T>;
+};
+
+template <>
+struct ColumnStorage<bool>
+{
+  using type = std::vector<std::uint8_t>;
+};
+
+template <>
+struct ColumnStorage<std::string>
+{
+  using type = StringColumn;
+};
+
+template <>
+struct ColumnStorage<char*>
+{
+  using type = StringColumn;
+};
+
+template <typename T>
+struct ColumnStorage<std::optional<T>>
+{
+  using type = NullableColumn<typename ColumnStorage<T>::type>;
+};
+
+template <typename T>
+using ColumnStorage_t = typename ColumnStorage<T>::type;
+
+/** Decodes the fetched value of a slot at the end of a column.
+ *
+ * `bound` is the attribute that was given to `bind` for this slot.
+ */
+template <std::size_t NBINDS, typename T, typename Value>
+void appendColumn(MYSQL_STMT& stmt,
+                  OutputBindArray<NBINDS>& binds,
+                  std::size_t idx,
+                  T const& bound,
+                  std::vector<Value>& column)
+{
+  if constexpr (std::is_same_v<T, Value>)
+    binds.finalize(stmt, idx, bound, column.emplace_back());
+  else
+  {
+    // The column stores another type (see `ColumnStorage`).
+    auto value = T{};
+    binds.finalize(stmt, idx, bound, value);
+    column.push_back(static_cast<Value>(value));
+  }
+}
+
+template <std::size_t NBINDS, typename T>
+void appendColumn(MYSQL_STMT& stmt,
+                  OutputBindArray<NBINDS>& binds,
+                  std::size_t idx,
+                  T const& bound,
+                  StringColumn& column)
+{
+  auto const length = binds.isNull(idx) ? 0 : binds.length(idx);
+  auto* dest = column.extend(length);
+  if constexpr (std::is_same_v<T, std::string>)
+    binds.copyText(stmt, idx, bound.data(), dest);
+  else
+    binds.copyText(stmt, idx, bound, dest);
+}
+
+template <std::size_t NBINDS, typename T, typename Values>
+void appendColumn(MYSQL_STMT& stmt,
+                  OutputBindArray<NBINDS>& binds,
+                  std::size_t idx,
+                  std::optional<T> const& bound,
+                  NullableColumn<Values>& column)
+{
+  auto const valid = !binds.isNull(idx);
+  auto& values = column.extend(valid);
+  if (!valid)
+  {
+    if constexpr (std::is_same_v<Values, StringColumn>)
+      values.extend(0);
+    else
+      values.emplace_back();
+  }
+  // `bind` engaged optionals, so `bound` always holds a value.
+  else
+    appendColumn(stmt, binds, idx, *bound, values);
+}
+}
+
+/** Result of a `GetAll` query, stored by column rather than by row.
+ *
+ * Holds one column per selected attribute, in the order of `Attrs` (see
+ * `details::ColumnStorage`). Values of a row have the same index in all
+ * columns. Rows are decoded from the output binds straight into the columns,
+ * without building models.
+ *
+ * Columns are retrieved with `get<&Model::attribute>()`.
+ */
+template <auto... Attrs>
+class ColumnarResult
+{
+public:
+  using columns_type = std::tuple<
+      details::ColumnStorage_t<meta::AttributeGetter_t<decltype(Attrs)>>...>;
+
+  ColumnarResult() : columns{}, nb_rows{0}
+  {
+  }
+
+  std::size_t size() const noexcept
+  {
+    return this->nb_rows;
+  }
+
+  bool empty() const noexcept
+  {
+    return this->nb_rows == 0;
+  }
+
+  template <auto Attr>
+  auto const& get() const noexcept
+  {
+    static_assert(indexOf<Attr>() < sizeof...(Attrs),
+                  "Attribute was not selected");
+    return std::get<indexOf<Attr>()>(this->columns);
+  }
+
+  void reserve(std::size_t capacity)
+  {
+    std::apply([&](auto&... column) { (column.reserve(capacity), ...); },
+               this->columns);
+  }
+
+  /** Decodes the fetched row, bound to `bound`, at the end of the columns.
+   *
+   * Slots are bound in the order of `Attrs` (see `GetAll::bindOutTo`).
+   */
+  template <typename Model, std::size_t NBINDS>
+  void append(MYSQL_STMT& stmt,
+              Model const& bound,
+              OutputBindArray<NBINDS>& binds)
+  {
+    this->appendImpl(
+        stmt, bound, binds, std::index_sequence_for<decltype(Attrs)...>{});
+    ++this->nb_rows;
+  }
+
+private:
+  template <auto Attr>
+  static constexpr std::size_t indexOf() noexcept
+  {
+    constexpr bool matches[] = {meta::TypeValEquals_v<Attr, Attrs>...};
+    for (auto i = std::size_t{0}; i < sizeof...(Attrs); ++i)
+      if (matches[i])
+        return i;
+    return sizeof...(Attrs);
+  }
+
+  template <typename Model, std::size_t NBINDS, std::size_t... Is>
+  void appendImpl(MYSQL_STMT& stmt,
+                  Model const& bound,
+                  OutputBindArray<NBINDS>& binds,
+                  std::index_sequence<Is...>)
+  {
+    (details::appendColumn(
+         stmt, binds, Is, bound.*Attrs, std::get<Is>(this->columns)),
+     ...);
+  }
+
+  columns_type columns;
+  std::size_t nb_rows;
+};
+
+namespace details
+{
+/** Metafunction returning the `ColumnarResult` of a `GetAll` query.
+ *
+ * Specialized for `GetAll` and for continuations of queries.
+ */
+template <typename Query>
+struct ColumnarResultOf;
+
+template <typename Query>
+using ColumnarResultOf_t = typename ColumnarResultOf<Query>::type;
+}
+}
+
+#endif /* !MYSQL_ORM_COLUMNARRESULT_HPP_ */
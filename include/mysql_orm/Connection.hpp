@@ -8,11 +8,35 @@
 
 #include <mysql_orm/Exception.hh>
 
+/** Defined if the client library has non-blocking functions (MariaDB's).
+ *
+ * May also be defined before including mysql_orm for other client libraries
+ * providing them.
+ */
+#if !defined(MYSQL_ORM_HAS_NONBLOCK) && \
+    (defined(MARIADB_BASE_VERSION) || defined(MARIADB_PACKAGE_VERSION))
+#define MYSQL_ORM_HAS_NONBLOCK
+#endif
+
 namespace mysql_orm
 {
 template <typename...>
 class Database;
 
+/** Capabilities of a connection, negotiated when connecting.
+ */
+struct ConnectionOptions
+{
+  // Allows the non-blocking client functions (see `AsyncQuery`). Requires
+  // `MYSQL_ORM_HAS_NONBLOCK`.
+  bool nonblocking{false};
+  // Allows `LOAD DATA LOCAL INFILE` (see `BulkLoad`). The server must allow
+  // it too (`local_infile`).
+  bool local_infile{false};
+};
+
+/** A connection to a MySQL server.
+ */
 class Connection
 {
 public:
@@ -20,9 +44,24 @@ public:
              unsigned short port,
              std::string const& username,
              std::string const& password,
-             std::string const& database)
+             std::string const& database,
+             ConnectionOptions options = {})
     : handle{mysql_init(nullptr), &mysql_close}
   {
+#ifdef MYSQL_ORM_HAS_NONBLOCK
+    if (options.nonblocking &&
+        mysql_options(this->handle.get(), MYSQL_OPT_NONBLOCK, nullptr))
+      throw MySQLException("Failed to enable non-blocking mode");
+#else
+    if (options.nonblocking)
+      throw Exception("Non-blocking connections require MariaDB's client "
+                      "library");
+#endif
+    // Must be set before connecting, so that the client announces it.
+    auto local_infile = static_cast<unsigned int>(options.local_infile);
+    if (mysql_options(
+            this->handle.get(), MYSQL_OPT_LOCAL_INFILE, &local_infile))
+      throw MySQLException("Failed to set local infile");
     if (!mysql_real_connect(this->handle.get(),
                             host.c_str(),
                             username.c_str(),
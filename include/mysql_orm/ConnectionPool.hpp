@@ -0,0 +1,269 @@
+#ifndef MYSQL_ORM_CONNECTIONPOOL_HPP_
+#define MYSQL_ORM_CONNECTIONPOOL_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Connection.hpp>
+#include <mysql_orm/Exception.hh>
+#include <mysql_orm/StatementCache.hpp>
+
+namespace mysql_orm
+{
+/** A thread-safe pool of connections.
+ *
+ * Connections are leased with `lease`, which returns a `Lease`. The
+ * connection goes back to the pool when the lease is destroyed. Each
+ * connection has its own `StatementCache`, which is kept across leases.
+ *
+ * `min_size` connections are opened upon construction. More are opened when
+ * needed, up to `max_size`. When all of them are leased, `lease` waits for one
+ * to be returned. All connections are made with `options`.
+ *
+ * Leasing and returning an idle connection does not take any lock: each
+ * connection has an atomic state, and threads start looking for an idle one
+ * at different positions.
+ *
+ * All leases must have been destroyed before the pool is.
+ */
+class ConnectionPool
+{
+  enum class State : unsigned char
+  {
+    Empty,
+    Idle,
+    Leased
+  };
+
+  struct Slot
+  {
+    std::atomic<State> state{State::Empty};
+    std::optional<Connection> connection{};
+    // Declared after the connection so that statements are closed first.
+    StatementCache stmt_cache{};
+  };
+
+public:
+  /** A leased connection.
+   *
+   * The connection is given back to the pool upon destruction.
+   */
+  class Lease
+  {
+  public:
+    Lease(Lease const& b) = delete;
+    Lease(Lease&& b) noexcept : pool{b.pool}, slot{b.slot}
+    {
+      b.slot = nullptr;
+    }
+    ~Lease() noexcept
+    {
+      if (this->slot)
+        this->pool->giveBack(*this->slot);
+    }
+
+    Lease& operator=(Lease const& rhs) = delete;
+    Lease& operator=(Lease&& rhs) noexcept
+    {
+      if (this != &rhs)
+      {
+        if (this->slot)
+          this->pool->giveBack(*this->slot);
+        this->pool = rhs.pool;
+        this->slot = rhs.slot;
+        rhs.slot = nullptr;
+      }
+      return *this;
+    }
+
+    MYSQL* getHandle() noexcept
+    {
+      return this->slot->connection->getHandle();
+    }
+
+    StatementCache* getStatementCache() noexcept
+    {
+      return &this->slot->stmt_cache;
+    }
+
+  private:
+    friend class ConnectionPool;
+
+    Lease(ConnectionPool& p, Slot& s) noexcept : pool{&p}, slot{&s}
+    {
+    }
+
+    ConnectionPool* pool;
+    // nullptr if moved from.
+    Slot* slot;
+  };
+
+  ConnectionPool(std::string phost,
+                 unsigned short pport,
+                 std::string pusername,
+                 std::string ppassword,
+                 std::string pdatabase,
+                 std::size_t min_size,
+                 std::size_t max_size,
+                 ConnectionOptions poptions = {})
+    : host{std::move(phost)},
+      port{pport},
+      username{std::move(pusername)},
+      password{std::move(ppassword)},
+      database{std::move(pdatabase)},
+      options{poptions},
+      nb_slots{max_size},
+      slots{std::make_unique<Slot[]>(max_size)},
+      waiters{0},
+      mutex{},
+      returned{}
+  {
+    if (max_size == 0 || min_size > max_size)
+      throw Exception("Invalid connection pool size");
+    // mysql_init is not thread-safe until the library is initialized.
+    if (mysql_library_init(0, nullptr, nullptr))
+      throw MySQLException("Failed to initialize MySQL library");
+    for (auto i = std::size_t{0}; i < min_size; ++i)
+    {
+      this->open(this->slots[i]);
+      this->slots[i].state.store(State::Idle, std::memory_order_release);
+    }
+  }
+
+  ConnectionPool(ConnectionPool const& b) = delete;
+  ConnectionPool(ConnectionPool&& b) = delete;
+  ~ConnectionPool() noexcept = default;
+
+  ConnectionPool& operator=(ConnectionPool const& rhs) = delete;
+  ConnectionPool& operator=(ConnectionPool&& rhs) = delete;
+
+  /** Leases a connection.
+   *
+   * Throws a `TimeoutException` if no connection could be leased before
+   * `timeout`.
+   */
+  Lease lease(std::chrono::milliseconds timeout = std::chrono::seconds{30})
+  {
+    if (auto* slot = this->tryAcquire())
+      return Lease{*this, *slot};
+
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    auto lock = std::unique_lock<std::mutex>{this->mutex};
+    this->waiters.fetch_add(1);
+    // Pairs with the fence in `giveBack`: either this thread sees the slot
+    // given back, or `giveBack` sees the waiter and notifies.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const guard = std::unique_ptr<std::atomic<std::size_t>,
+                                       void (*)(std::atomic<std::size_t>*)>{
+        &this->waiters, [](auto* w) { w->fetch_sub(1); }};
+    while (true)
+    {
+      if (auto* slot = this->tryAcquire())
+        return Lease{*this, *slot};
+      if (this->returned.wait_until(lock, deadline) ==
+          std::cv_status::timeout)
+      {
+        if (auto* slot = this->tryAcquire())
+          return Lease{*this, *slot};
+        throw TimeoutException("Timed out waiting for a connection");
+      }
+    }
+  }
+
+  /** Returns the maximal number of connections.
+   */
+  std::size_t capacity() const noexcept
+  {
+    return this->nb_slots;
+  }
+
+private:
+  void open(Slot& slot)
+  {
+    slot.connection.emplace(this->host,
+                            this->port,
+                            this->username,
+                            this->password,
+                            this->database,
+                            this->options);
+  }
+
+  /** Leases an idle connection, or opens a new one.
+   *
+   * Returns nullptr if all connections are leased.
+   */
+  Slot* tryAcquire()
+  {
+    // Threads start at different slots so as not to contend on the same ones.
+    auto const start =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+        this->nb_slots;
+    for (auto i = std::size_t{0}; i < this->nb_slots; ++i)
+    {
+      auto& slot = this->slots[(start + i) % this->nb_slots];
+      auto expected = State::Idle;
+      if (slot.state.load(std::memory_order_relaxed) == State::Idle &&
+          slot.state.compare_exchange_strong(
+              expected, State::Leased, std::memory_order_acquire))
+        return &slot;
+    }
+    for (auto i = std::size_t{0}; i < this->nb_slots; ++i)
+    {
+      auto& slot = this->slots[(start + i) % this->nb_slots];
+      auto expected = State::Empty;
+      if (slot.state.compare_exchange_strong(
+              expected, State::Leased, std::memory_order_acquire))
+      {
+        try
+        {
+          this->open(slot);
+        }
+        catch (...)
+        {
+          this->giveBack(slot, State::Empty);
+          throw;
+        }
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
+
+  void giveBack(Slot& slot, State state = State::Idle) noexcept
+  {
+    slot.state.store(state, std::memory_order_release);
+    // Orders the store before the load of `waiters` (see `lease`).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Only take the lock if someone is waiting.
+    if (this->waiters.load(std::memory_order_relaxed) > 0)
+    {
+      auto const lock = std::lock_guard<std::mutex>{this->mutex};
+      this->returned.notify_one();
+    }
+  }
+
+  std::string host;
+  unsigned short port;
+  std::string username;
+  std::string password;
+  std::string database;
+  ConnectionOptions options;
+  std::size_t nb_slots;
+  std::unique_ptr<Slot[]> slots;
+  std::atomic<std::size_t> waiters;
+  std::mutex mutex;
+  std::condition_variable returned;
+};
+}
+
+#endif /* !MYSQL_ORM_CONNECTIONPOOL_HPP_ */
@@ -1,15 +1,29 @@
 #ifndef MYSQL_ORM_DATABASE_HPP_
 #define MYSQL_ORM_DATABASE_HPP_
 
+#include <iterator>
+#include <map>
 #include <memory>
 #include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
 
 #include <CompileString/CompileString.hpp>
 #include <mysql/mysql.h>
 
 #include <mysql_orm/Connection.hpp>
+#include <mysql_orm/ConnectionPool.hpp>
 #include <mysql_orm/Delete.hpp>
 #include <mysql_orm/Exception.hh>
+#include <mysql_orm/GetByIds.hpp>
+#include <mysql_orm/Insert.hpp>
+#include <mysql_orm/Join.hpp>
+#include <mysql_orm/Metrics.hpp>
+#include <mysql_orm/Paginator.hpp>
+#include <mysql_orm/QueryAuditor.hpp>
+#include <mysql_orm/Relation.hpp>
+#include <mysql_orm/StatementCache.hpp>
 #include <mysql_orm/Table.hpp>
 #include <mysql_orm/Update.hpp>
 #include <mysql_orm/meta/AllSame.hpp>
@@ -27,7 +41,23 @@ class Database
 
 public:
   constexpr Database(MYSQL* hdl, Tables&&... tabls)
-    : handle{hdl}, tables{std::forward_as_tuple(tabls...)}
+    : handle{hdl},
+      tables{std::forward_as_tuple(tabls...)},
+      owned_stmt_cache{std::make_unique<StatementCache>()},
+      stmt_cache{owned_stmt_cache.get()}
+  {
+  }
+
+  /** Uses `cache` instead of a cache of its own.
+   *
+   * The cache must hold statements prepared on `hdl` only, and must outlive
+   * the database.
+   */
+  constexpr Database(MYSQL* hdl, StatementCache* cache, Tables&&... tabls)
+    : handle{hdl},
+      tables{std::forward_as_tuple(tabls...)},
+      owned_stmt_cache{},
+      stmt_cache{cache}
   {
   }
 
@@ -56,7 +86,8 @@ public:
   template <typename Model>
   constexpr auto getAll()
   {
-    return this->getTable<Model>().getAll(*this->getMYSQLHandle());
+    return this->getTable<Model>().getAll(*this->getMYSQLHandle(),
+                                         this->getStatementCache());
   }
 
   template <auto Attr, auto... Attrs>
@@ -65,13 +96,181 @@ public:
     this->checkAttributes<Attr, Attrs...>();
     using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
     return this->getTable<Model_t>().template getAll<Attr, Attrs...>(
-        *this->getMYSQLHandle());
+        *this->getMYSQLHandle(), this->getStatementCache());
+  }
+
+  /** Returns a query counting the rows of the table of `Model`.
+   */
+  template <typename Model>
+  constexpr auto count()
+  {
+    return this->getTable<Model>()
+        .template aggregate<AggregateFunction::Count>(
+            *this->getMYSQLHandle(), this->getStatementCache());
+  }
+
+  template <auto Attr>
+  constexpr auto sum()
+  {
+    return this->aggregate<AggregateFunction::Sum, Attr>();
+  }
+
+  template <auto Attr>
+  constexpr auto min()
+  {
+    return this->aggregate<AggregateFunction::Min, Attr>();
+  }
+
+  template <auto Attr>
+  constexpr auto max()
+  {
+    return this->aggregate<AggregateFunction::Max, Attr>();
+  }
+
+  template <auto Attr>
+  constexpr auto avg()
+  {
+    return this->aggregate<AggregateFunction::Avg, Attr>();
+  }
+
+  /** Returns a query computing `F` over `Attr`, server-side.
+   */
+  template <AggregateFunction F, auto Attr>
+  constexpr auto aggregate()
+  {
+    this->checkAttributes<Attr>();
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    return this->getTable<Model_t>().template aggregate<F, Attr>(
+        *this->getMYSQLHandle(), this->getStatementCache());
+  }
+
+  /** Returns a query selecting columns and aggregates (see `Projection`).
+   *
+   * All projections must refer to the same model.
+   */
+  template <typename... Projections>
+  constexpr auto select()
+  {
+    using Model_t = details::ProjectionModel_t<Projections...>;
+    return this->getTable<Model_t>().template project<Projections...>(
+        *this->getMYSQLHandle(), this->getStatementCache());
+  }
+
+  /** Returns a query selecting the rows of the tables of `ModelA` and `ModelB`
+   * that satisfy `on` (see `Join`).
+   *
+   * Rows are `std::pair<ModelA, ModelB>`. Attributes in `on` and in the
+   * clauses continuing the query may refer to either model.
+   */
+  template <typename ModelA, typename ModelB, typename Condition>
+  auto join(On<Condition> on)
+  {
+    auto const& joined = this->getJoinedTables<ModelA, ModelB>();
+    return Join<std::remove_cv_t<std::remove_reference_t<decltype(joined)>>,
+                Condition>{*this->getMYSQLHandle(),
+                           joined,
+                           std::move(on.condition),
+                           this->getStatementCache()};
+  }
+
+  /** Selects the models whose `Attr` is one of `ids`, in the order of `ids`.
+   *
+   * Ids that match no row are skipped. Keys are sent in batched `IN` lists
+   * (see `details::getByIds`).
+   */
+  template <auto Attr, typename Container>
+  auto getByIds(Container const& ids)
+  {
+    auto const by_id = this->getMapByIds<Attr>(ids);
+    auto ret = std::vector<meta::AttributeModelGetter_t<decltype(Attr)>>{};
+    ret.reserve(by_id.size());
+    for (auto const& id : ids)
+    {
+      auto it = by_id.find(id);
+      if (it != by_id.end())
+        ret.push_back(it->second);
+    }
+    return ret;
+  }
+
+  /** Selects the models whose `Attr` is one of `ids`, keyed by `Attr`.
+   */
+  template <auto Attr, typename Container>
+  auto getMapByIds(Container const& ids)
+  {
+    this->checkAttributes<Attr>();
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    auto ret =
+        std::map<meta::AttributeGetter_t<decltype(Attr)>, Model_t>{};
+    details::getByIds<Attr>(*this->getMYSQLHandle(),
+                            this->getTable<Model_t>(),
+                            this->getStatementCache(),
+                            std::begin(ids),
+                            std::end(ids),
+                            [&](Model_t&& model) {
+                              auto key = model.*Attr;
+                              ret.insert_or_assign(std::move(key),
+                                                   std::move(model));
+                            });
+    return ret;
+  }
+
+  /** Executes `query`, then loads the children of the selected models for
+   * each of `Relations` (see `HasMany`).
+   *
+   * This takes one query per relation and per 128 distinct parent keys,
+   * instead of one per parent.
+   */
+  template <typename Relation, typename... Relations, typename Query>
+  auto eager(Query const& query)
+  {
+    auto parents = query.build().execute();
+    this->load<Relation, Relations...>(parents);
+    return parents;
+  }
+
+  /** Loads the children of `parents` for each of `Relations`, and appends
+   * them to their parent.
+   */
+  template <typename Relation, typename... Relations, typename Container>
+  void load(Container& parents)
+  {
+    details::loadRelation<Relation>(
+        *this->getMYSQLHandle(),
+        this->getTable<typename Relation::child_type>(),
+        this->getStatementCache(),
+        std::begin(parents),
+        std::end(parents));
+    (details::loadRelation<Relations>(
+         *this->getMYSQLHandle(),
+         this->getTable<typename Relations::child_type>(),
+         this->getStatementCache(),
+         std::begin(parents),
+         std::end(parents)),
+     ...);
+  }
+
+  /** Returns a `Paginator` over the pages of `page_size` rows of the table,
+   * ordered by `Attr`, which must be unique.
+   */
+  template <auto Attr>
+  auto paginate(std::size_t page_size)
+  {
+    this->checkAttributes<Attr>();
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    using Table_t = std::remove_cv_t<
+        std::remove_reference_t<decltype(this->getTable<Model_t>())>>;
+    return Paginator<Attr, Table_t>{*this->getMYSQLHandle(),
+                                    this->getTable<Model_t>(),
+                                    this->getStatementCache(),
+                                    page_size};
   }
 
   template <typename Model>
   constexpr auto insert(Model const& model)
   {
-    return this->getTable<Model>().insert(*this->getMYSQLHandle(), &model);
+    return this->getTable<Model>().insert(
+        *this->getMYSQLHandle(), &model, this->getStatementCache());
   }
 
   template <auto Attr,
@@ -82,7 +281,7 @@ public:
     this->checkAttributes<Attr, Attrs...>();
     using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
     return this->getTable<Model_t>().template insert<Attr, Attrs...>(
-        *this->getMYSQLHandle(), &model);
+        *this->getMYSQLHandle(), &model, this->getStatementCache());
   }
 
   template <auto Attr,
@@ -93,7 +292,72 @@ public:
     this->checkAttributes<Attr, Attrs...>();
     using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
     return this->getTable<Model_t>().template insertAllBut<Attr, Attrs...>(
-        *this->getMYSQLHandle(), &model);
+        *this->getMYSQLHandle(), &model, this->getStatementCache());
+  }
+
+  /** Inserts all models of a range.
+   *
+   * Rows are sent `NROWS` at a time, using multi-row `INSERT` queries.
+   */
+  template <typename Iterator, std::size_t NROWS = BatchSize<>::value>
+  void insert(Iterator first, Iterator last, BatchSize<NROWS> = {})
+  {
+    using Model = typename std::iterator_traits<Iterator>::value_type;
+    this->getTable<Model>().template insertRange<NROWS>(
+        *this->getMYSQLHandle(), first, last, this->getStatementCache());
+  }
+
+  template <auto Attr,
+            auto... Attrs,
+            typename Iterator,
+            std::size_t NROWS = BatchSize<>::value>
+  void insert(Iterator first, Iterator last, BatchSize<NROWS> = {})
+  {
+    this->checkAttributes<Attr, Attrs...>();
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    this->getTable<Model_t>().template insertRange<NROWS, Attr, Attrs...>(
+        *this->getMYSQLHandle(), first, last, this->getStatementCache());
+  }
+
+  template <auto Attr,
+            auto... Attrs,
+            typename Iterator,
+            std::size_t NROWS = BatchSize<>::value>
+  void insertAllBut(Iterator first, Iterator last, BatchSize<NROWS> = {})
+  {
+    this->checkAttributes<Attr, Attrs...>();
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    this->getTable<Model_t>()
+        .template insertRangeAllBut<NROWS, Attr, Attrs...>(
+            *this->getMYSQLHandle(), first, last, this->getStatementCache());
+  }
+
+  /** Inserts all models of a container.
+   */
+  template <typename Container, std::size_t NROWS = BatchSize<>::value>
+  void insertMany(Container const& models, BatchSize<NROWS> batch = {})
+  {
+    this->insert(std::begin(models), std::end(models), batch);
+  }
+
+  /** Loads all models of a range with `LOAD DATA LOCAL INFILE`.
+   *
+   * This is faster than `insert` for large ranges. The connection must be
+   * made with `local_infile` set, and the server must allow it. Returns the
+   * number of loaded rows.
+   */
+  template <typename Iterator>
+  std::size_t bulkLoad(Iterator first, Iterator last)
+  {
+    using Model = typename std::iterator_traits<Iterator>::value_type;
+    return this->getTable<Model>().bulkLoad(
+        *this->getMYSQLHandle(), first, last)();
+  }
+
+  template <typename Container>
+  std::size_t bulkLoad(Container const& models)
+  {
+    return this->bulkLoad(std::begin(models), std::end(models));
   }
 
   template <typename Model>
@@ -104,7 +368,9 @@ public:
     static_assert(!std::is_same_v<Table_t, void>,
                   "Failed to find table for model");
     return Update<std::remove_reference_t<Table_t>>{
-        *this->getMYSQLHandle(), std::get<Table_t>(this->tables)};
+        *this->getMYSQLHandle(),
+        std::get<Table_t>(this->tables),
+        this->getStatementCache()};
   }
 
   template <typename Model>
@@ -115,7 +381,9 @@ public:
     static_assert(!std::is_same_v<Table_t, void>,
                   "Failed to find table for model");
     return Delete<std::remove_reference_t<Table_t>>{
-        *this->getMYSQLHandle(), std::get<Table_t>(this->tables)};
+        *this->getMYSQLHandle(),
+        std::get<Table_t>(this->tables),
+        this->getStatementCache()};
   }
 
   void recreate()
@@ -163,6 +431,59 @@ public:
     this->execute("DROP TABLE IF EXISTS `" + table.getName() + '`');
   }
 
+  /** Adds partition `name` to the table of `Model`, which must be
+   * partitioned by range (see `PartitionByRange`).
+   *
+   * The partition holds the rows whose partitioning column is lower than
+   * `bound`, and not held by a previous partition. `bound` must be greater
+   * than that of previous partitions.
+   */
+  template <typename Model, typename Bound>
+  void addPartition(std::string const& name, Bound const& bound)
+  {
+    this->execute(this->getTable<Model>().getAddPartitionQuery(name, bound));
+  }
+
+  /** Drops partition `name` of the table of `Model`, and all its rows.
+   */
+  template <typename Model>
+  void dropPartition(std::string const& name)
+  {
+    this->execute(this->getTable<Model>().getDropPartitionQuery(name));
+  }
+
+  /** Audits the plans of the queries with `auditor` (see `QueryAuditor`).
+   *
+   * The auditor is set on the statement cache, so it is shared with the
+   * databases using the same cache. `nullptr` disables auditing.
+   */
+  void setAuditor(QueryAuditor* auditor) noexcept
+  {
+    this->stmt_cache->setAuditor(auditor);
+  }
+
+  /** Records the metrics of the queries into `metrics` (see
+   * `MetricsRegistry`).
+   *
+   * The registry is set on the statement cache, so it is shared with the
+   * databases using the same cache. `nullptr` disables metrics.
+   */
+  void setMetrics(MetricsRegistry* metrics) noexcept
+  {
+    this->stmt_cache->setMetrics(metrics);
+  }
+
+  /** Returns the cache of prepared statements used by the queries.
+   *
+   * Statements are reused across queries with the same type and SQL text.
+   * Use `setCapacity` on the cache to bound the number of statements kept
+   * prepared on the server.
+   */
+  StatementCache* getStatementCache() noexcept
+  {
+    return this->stmt_cache;
+  }
+
 private:
   constexpr MYSQL* getMYSQLHandle() noexcept
   {
@@ -179,6 +500,26 @@ private:
     return std::get<Table_t>(this->tables);
   }
 
+  /** Returns the tables of `ModelA` and `ModelB`, joined.
+   *
+   * Queries refer to their table by address, so joined tables are made once
+   * and kept by the database.
+   */
+  template <typename ModelA, typename ModelB>
+  auto const& getJoinedTables()
+  {
+    using TableA_t =
+        std::remove_reference_t<decltype(this->getTable<ModelA>())>;
+    using TableB_t =
+        std::remove_reference_t<decltype(this->getTable<ModelB>())>;
+    using Joined_t = JoinedTables<TableA_t, TableB_t>;
+    auto& joined = this->joined_tables[std::type_index{typeid(Joined_t)}];
+    if (!joined)
+      joined = std::make_shared<Joined_t>(this->getTable<ModelA>(),
+                                          this->getTable<ModelB>());
+    return *static_cast<Joined_t const*>(joined.get());
+  }
+
   template <auto Attr, auto... Attrs>
   constexpr void checkAttributes() const noexcept
   {
@@ -195,6 +536,12 @@ private:
 
   MYSQL* handle;
   std::tuple<Tables...> tables;
+  // Behind a pointer so that queries stay valid if the database is moved.
+  std::unique_ptr<StatementCache> owned_stmt_cache;
+  // May not be nullptr.
+  StatementCache* stmt_cache;
+  // Type-erased `JoinedTables`, by type. See `getJoinedTables`.
+  std::map<std::type_index, std::shared_ptr<void>> joined_tables;
 };
 
 template <typename... Tables>
@@ -202,6 +549,19 @@ constexpr auto make_database(Connection& hdl, Tables&&... tables)
 {
   return Database<Tables...>{hdl.getHandle(), std::forward<Tables>(tables)...};
 }
+
+/** Makes a database using a leased connection and its statement cache.
+ *
+ * The lease must outlive the database. Making a database is cheap, so one can
+ * be made for each scope that needs a connection.
+ */
+template <typename... Tables>
+constexpr auto make_database(ConnectionPool::Lease& lease, Tables&&... tables)
+{
+  return Database<Tables...>{lease.getHandle(),
+                             lease.getStatementCache(),
+                             std::forward<Tables>(tables)...};
+}
 }
 
 #endif /* !MYSQL_ORM_DATABASE_HPP_ */
@@ -3,11 +3,13 @@
 
 #include <functional>
 #include <sstream>
+#include <string_view>
 
 #include <mysql/mysql.h>
 
 #include <mysql_orm/Limit.hpp>
 #include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/SQLText.hpp>
 #include <mysql_orm/Where.hpp>
 
 namespace mysql_orm
@@ -20,8 +22,10 @@ public:
   using table_type = Table;
   static inline constexpr auto query_type{QueryType::Delete};
 
-  constexpr Delete(MYSQL& mysql, Table const& t) noexcept
-    : mysql_handle{&mysql}, table{&t}
+  constexpr Delete(MYSQL& mysql,
+                   Table const& t,
+                   StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
   {
   }
   constexpr Delete(Delete const& b) noexcept = default;
@@ -31,9 +35,14 @@ public:
   constexpr Delete& operator=(Delete const& rhs) noexcept = default;
   constexpr Delete& operator=(Delete&& rhs) noexcept = default;
 
-  constexpr auto buildquery() const noexcept
+  std::string_view buildquery() const
   {
-    return this->buildqueryCS();
+    return details::SQLText<Delete>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
   }
 
   constexpr auto buildqueryCS() const noexcept
@@ -65,6 +74,11 @@ public:
     return this->build().execute();
   }
 
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
   static constexpr size_t getNbInputSlots() noexcept
   {
     return 0;
@@ -90,6 +104,7 @@ private:
   // incomplete.
   MYSQL* mysql_handle;
   Table const* table;
+  StatementCache* stmt_cache;
 };
 }
 
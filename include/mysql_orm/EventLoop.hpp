@@ -0,0 +1,205 @@
+#ifndef MYSQL_ORM_EVENTLOOP_HPP_
+#define MYSQL_ORM_EVENTLOOP_HPP_
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Connection.hpp>
+#include <mysql_orm/Exception.hh>
+
+#ifndef MYSQL_ORM_HAS_NONBLOCK
+#error "Asynchronous queries require MariaDB's client library"
+#endif
+
+namespace mysql_orm
+{
+/** Single-threaded epoll executor for non-blocking MySQL operations.
+ *
+ * Operations register what they are waiting for with `wait`, and `run`
+ * dispatches readiness to them until none are left. Many connections may have
+ * an operation in flight at the same time, but each connection only one.
+ *
+ * Callbacks are called from `run` and `runOnce`. Exceptions they throw are
+ * propagated from there.
+ */
+class EventLoop
+{
+public:
+  EventLoop() : epoll_fd{epoll_create1(EPOLL_CLOEXEC)}, waits{}
+  {
+    if (this->epoll_fd < 0)
+      throw Exception("Failed to create epoll instance: " +
+                      std::string{std::strerror(errno)});
+  }
+
+  EventLoop(EventLoop const& b) = delete;
+  EventLoop(EventLoop&& b) = delete;
+  ~EventLoop() noexcept
+  {
+    close(this->epoll_fd);
+  }
+
+  EventLoop& operator=(EventLoop const& rhs) = delete;
+  EventLoop& operator=(EventLoop&& rhs) = delete;
+
+  /** Calls `callback` once the socket of `mysql` is ready.
+   *
+   * `status` is the value returned by a `_start` or `_cont` function, i.e. a
+   * mask of `MYSQL_WAIT_*`. `callback` receives the mask of the events that
+   * occurred, to be passed to the matching `_cont` function.
+   */
+  void wait(MYSQL& mysql, int status, std::function<void(int)> callback)
+  {
+    auto const fd = mysql_get_socket(&mysql);
+    auto w = Wait{status, {}, std::move(callback)};
+    if (status & MYSQL_WAIT_TIMEOUT)
+      w.deadline = std::chrono::steady_clock::now() +
+                   std::chrono::seconds{mysql_get_timeout_value(&mysql)};
+    auto event = epoll_event{};
+    event.events = toEpollEvents(status);
+    event.data.fd = fd;
+    if (event.events &&
+        epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+      throw Exception("Failed to watch MySQL socket: " +
+                      std::string{std::strerror(errno)});
+    this->waits.insert_or_assign(fd, std::move(w));
+  }
+
+  /** Dispatches events until no operation is pending.
+   */
+  void run()
+  {
+    while (!this->waits.empty())
+      this->runOnce(-1);
+  }
+
+  /** Waits for events at most `timeout_ms` milliseconds (-1 for no limit) and
+   * dispatches them.
+   *
+   * Returns the number of callbacks called.
+   */
+  std::size_t runOnce(int timeout_ms)
+  {
+    if (this->waits.empty())
+      return 0;
+    auto const now = std::chrono::steady_clock::now();
+    for (auto const& [fd, w] : this->waits)
+      if (w.status & MYSQL_WAIT_TIMEOUT)
+      {
+        auto const left = std::max(
+            std::chrono::duration_cast<std::chrono::milliseconds>(w.deadline -
+                                                                  now)
+                .count(),
+            std::chrono::milliseconds::rep{0});
+        if (timeout_ms < 0 || left < timeout_ms)
+          timeout_ms = static_cast<int>(left);
+      }
+
+    epoll_event events[64];
+    auto const nb_events =
+        epoll_wait(this->epoll_fd, events, std::size(events), timeout_ms);
+    if (nb_events < 0)
+    {
+      if (errno == EINTR)
+        return 0;
+      throw Exception("Failed to wait for MySQL sockets: " +
+                      std::string{std::strerror(errno)});
+    }
+
+    auto ready = std::vector<std::pair<int, int>>{};
+    for (auto i = 0; i < nb_events; ++i)
+    {
+      // epoll_event is packed, its fields can't be bound to references.
+      auto const fd = int{events[i].data.fd};
+      ready.emplace_back(fd, fromEpollEvents(events[i].events));
+    }
+    auto const after = std::chrono::steady_clock::now();
+    for (auto const& [fd, w] : this->waits)
+      if ((w.status & MYSQL_WAIT_TIMEOUT) && w.deadline <= after &&
+          std::none_of(ready.begin(), ready.end(), [fd = fd](auto const& r) {
+            return r.first == fd;
+          }))
+        ready.emplace_back(fd, MYSQL_WAIT_TIMEOUT);
+
+    // Callbacks usually register a new wait for the same socket, so they are
+    // all taken out before any is called.
+    auto callbacks = std::vector<std::pair<std::function<void(int)>, int>>{};
+    for (auto const& [fd, events_mask] : ready)
+    {
+      auto it = this->waits.find(fd);
+      if (it == this->waits.end())
+        continue;
+      if (toEpollEvents(it->second.status))
+        epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+      callbacks.emplace_back(std::move(it->second.callback),
+                             events_mask & it->second.status);
+      this->waits.erase(it);
+    }
+    for (auto& [callback, events_mask] : callbacks)
+      callback(events_mask);
+    return callbacks.size();
+  }
+
+  /** Returns the number of operations waiting for their socket.
+   */
+  std::size_t pending() const noexcept
+  {
+    return this->waits.size();
+  }
+
+private:
+  struct Wait
+  {
+    int status;
+    std::chrono::steady_clock::time_point deadline;
+    std::function<void(int)> callback;
+  };
+
+  static std::uint32_t toEpollEvents(int status) noexcept
+  {
+    auto events = std::uint32_t{0};
+    if (status & MYSQL_WAIT_READ)
+      events |= EPOLLIN;
+    if (status & MYSQL_WAIT_WRITE)
+      events |= EPOLLOUT;
+    if (status & MYSQL_WAIT_EXCEPT)
+      events |= EPOLLPRI;
+    return events;
+  }
+
+  static int fromEpollEvents(std::uint32_t events) noexcept
+  {
+    auto status = 0;
+    // Errors and hang-ups are reported as readiness, so that the client
+    // library notices them.
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+      status |= MYSQL_WAIT_READ;
+    if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+      status |= MYSQL_WAIT_WRITE;
+    if (events & EPOLLPRI)
+      status |= MYSQL_WAIT_EXCEPT;
+    return status;
+  }
+
+  int epoll_fd;
+  // Keyed by socket.
+  std::map<int, Wait> waits;
+};
+}
+
+#endif /* !MYSQL_ORM_EVENTLOOP_HPP_ */
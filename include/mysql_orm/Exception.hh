@@ -37,6 +37,17 @@ public:
   }
 };
 
+/** Used to indicate that a resource could not be obtained in time.
+ */
+class TimeoutException : public Exception
+{
+public:
+  explicit TimeoutException(std::string what = "") noexcept
+    : Exception(std::move(what))
+  {
+  }
+};
+
 /** Used to indicate an error in a MySQL query.
  */
 class MySQLQueryException : public MySQLException
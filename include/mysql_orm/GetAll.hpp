@@ -2,12 +2,18 @@
 #define MYSQL_ORM_GETALL_HPP_
 
 #include <sstream>
+#include <string_view>
 #include <utility>
 
 #include <mysql/mysql.h>
 
+#include <mysql_orm/AsyncCallback.hpp>
+#include <mysql_orm/ColumnarResult.hpp>
 #include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
 #include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/RowStream.hpp>
+#include <mysql_orm/SQLText.hpp>
 #include <mysql_orm/Statement.hpp>
 #include <mysql_orm/Where.hpp>
 
@@ -21,10 +27,16 @@ namespace mysql_orm
  *
  * This query returns objects as opposed to raw columns.
  *
- * `buildquery` returns the SQL query as a std::string.
+ * `buildquery` returns a view of the SQL query.
  * `build` returns a `Statement`, which can later be `execute()`d.
+ * `stream` returns a `RowStream`, which fetches rows one at a time.
+ * `columns` returns the rows as a `ColumnarResult`, with one array per
+ * attribute.
+ * `async` executes the query on an `EventLoop` (see `AsyncQuery`, whose header
+ * must be included).
  *
- * The `operator()` can be used to continue the query (Where, Limit).
+ * The `operator()` can be used to continue the query (Where, OrderBy,
+ * Limit).
  */
 template <typename Table, auto... Attrs>
 class GetAll
@@ -34,8 +46,10 @@ public:
   using model_type = typename table_type::model_type;
   static inline constexpr auto query_type{QueryType::GetAll};
 
-  constexpr GetAll(MYSQL& mysql, Table const& t) noexcept
-    : mysql_handle{&mysql}, table{&t}
+  constexpr GetAll(MYSQL& mysql,
+                   Table const& t,
+                   StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
   {
   }
   constexpr GetAll(GetAll const& b) noexcept = default;
@@ -52,6 +66,14 @@ public:
         *this->mysql_handle, *this, *this->table, std::move(where.condition)};
   }
 
+  template <auto Attr, typename Direction>
+  constexpr OrderByQuery<GetAll, OrderBy<Attr, Direction>> operator()(
+      OrderBy<Attr, Direction> order)
+  {
+    return OrderByQuery<GetAll, OrderBy<Attr, Direction>>{
+        *this->mysql_handle, *this, *this->table, std::move(order)};
+  }
+
   template <typename Limit>
   constexpr LimitQuery<GetAll, Limit> operator()(Limit limit)
   {
@@ -64,9 +86,30 @@ public:
     return this->build().execute();
   }
 
-  constexpr auto buildquery() const noexcept
+  RowStream<GetAll, model_type> stream() const
+  {
+    return RowStream<GetAll, model_type>{*this};
+  }
+
+  ColumnarResult<Attrs...> columns() const
+  {
+    return this->build().template executeColumns<ColumnarResult<Attrs...>>();
+  }
+
+  void async(EventLoop& loop,
+             AsyncCallback<query_type, model_type> callback) const
+  {
+    AsyncQuery<GetAll, model_type>::start(*this, loop, std::move(callback));
+  }
+
+  std::string_view buildquery() const
   {
-    return this->buildqueryCS();
+    return details::SQLText<GetAll>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
   }
 
   constexpr auto buildqueryCS() const noexcept
@@ -79,6 +122,11 @@ public:
     return Statement<GetAll, model_type>{*this->mysql_handle, *this};
   }
 
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
   constexpr static size_t getNbInputSlots() noexcept
   {
     return 0;
@@ -109,11 +157,13 @@ public:
   }
 
   template <std::size_t NBINDS>
-  constexpr void finalizeBindings(model_type& model,
+  constexpr void finalizeBindings(MYSQL_STMT& stmt,
+                                  model_type const& bound,
+                                  model_type& model,
                                   OutputBindArray<NBINDS>& binds)
   {
     auto i = std::size_t{0};
-    (binds.finalize(i++, model.*Attrs), ...);
+    (binds.finalize(stmt, i++, bound.*Attrs, model.*Attrs), ...);
   }
 
 private:
@@ -121,7 +171,17 @@ private:
   // incomplete.
   MYSQL* mysql_handle;
   Table const* table;
+  StatementCache* stmt_cache;
 };
+
+namespace details
+{
+template <typename Table, auto... Attrs>
+struct ColumnarResultOf<GetAll<Table, Attrs...>>
+{
+  using type = ColumnarResult<Attrs...>;
+};
+}
 }
 
 #endif /* !MYSQL_ORM_GETALL_HPP_ */
@@ -0,0 +1,122 @@
+#ifndef MYSQL_ORM_GETBYIDS_HPP_
+#define MYSQL_ORM_GETBYIDS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+#include <CompileString/CompileString.hpp>
+#include <mysql/mysql.h>
+
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/Utils.hpp>
+#include <mysql_orm/Where.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+
+namespace mysql_orm
+{
+namespace details
+{
+/** Condition `attr IN (?, ..., ?)` with `N` keys, for use in a `Where`.
+ */
+template <auto Attr, std::size_t N>
+struct InCondition
+{
+  template <std::size_t M>
+  using CompileString = compile_string::CompileString<M>;
+
+  using key_type = meta::AttributeGetter_t<decltype(Attr)>;
+
+  template <std::size_t M, typename Table>
+  auto appendToQuery(CompileString<M> const& query, Table const& t) const
+  {
+    return query + "`" + t.template getColumn<Attr>().getName() + "` IN (" +
+           applyN<N - 1>([](auto const& acc) { return acc + ", ?"; },
+                         compile_string::CompileString{"?"}) +
+           ')';
+  }
+
+  static constexpr size_t getNbInputSlots() noexcept
+  {
+    return N;
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>& binds, std::size_t idx) const
+  {
+    for (auto i = std::size_t{0}; i < N; ++i)
+      binds.bind(idx + i, this->keys[i]);
+  }
+
+  template <std::size_t NBINDS>
+  void rebindStdTmReferences(InputBindArray<NBINDS>&, std::size_t) const
+      noexcept
+  {
+  }
+
+  std::array<key_type, N> keys;
+};
+
+/** Selects the models whose `Attr` is in `[first, last)` with at most `N`
+ * keys, and gives each of them to `sink`.
+ *
+ * If there are less than `N` keys, the last one is repeated, so that the
+ * statement only depends on `N`.
+ *
+ * Returns an iterator past the last key used.
+ */
+template <auto Attr,
+          std::size_t N,
+          typename Table,
+          typename Iterator,
+          typename Sink>
+Iterator getByIdsBucket(MYSQL& mysql,
+                        Table const& table,
+                        StatementCache* cache,
+                        Iterator first,
+                        Iterator last,
+                        Sink& sink)
+{
+  auto condition = InCondition<Attr, N>{};
+  auto i = std::size_t{0};
+  for (; i < N && first != last; ++i, ++first)
+    condition.keys[i] = *first;
+  for (; i < N; ++i)
+    condition.keys[i] = condition.keys[i - 1];
+  for (auto& model : table.getAll(mysql, cache)(Where{std::move(condition)})())
+    sink(std::move(model));
+  return first;
+}
+
+/** Selects the models whose `Attr` is in `[first, last)`, and gives each of
+ * them to `sink`, in no particular order.
+ *
+ * Keys are sent in `IN` lists of 1, 8, 32 or 128 keys, so that at most 4
+ * statements are prepared whatever the number of keys.
+ */
+template <auto Attr, typename Table, typename Iterator, typename Sink>
+void getByIds(MYSQL& mysql,
+              Table const& table,
+              StatementCache* cache,
+              Iterator first,
+              Iterator last,
+              Sink&& sink)
+{
+  while (first != last)
+  {
+    auto const remaining = std::distance(first, last);
+    if (remaining > 32)
+      first = getByIdsBucket<Attr, 128>(mysql, table, cache, first, last, sink);
+    else if (remaining > 8)
+      first = getByIdsBucket<Attr, 32>(mysql, table, cache, first, last, sink);
+    else if (remaining > 1)
+      first = getByIdsBucket<Attr, 8>(mysql, table, cache, first, last, sink);
+    else
+      first = getByIdsBucket<Attr, 1>(mysql, table, cache, first, last, sink);
+  }
+}
+}
+}
+
+#endif /* !MYSQL_ORM_GETBYIDS_HPP_ */
@@ -0,0 +1,247 @@
+#ifndef MYSQL_ORM_GROUPBY_HPP_
+#define MYSQL_ORM_GROUPBY_HPP_
+
+#include <cstddef>
+#include <utility>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/ColumnNamesJoiner.hpp>
+#include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
+#include <mysql_orm/QueryContinuation.hpp>
+#include <mysql_orm/WhereConditionDSL.hpp>
+
+namespace mysql_orm
+{
+/** Group by clause arguments.
+ *
+ * This class is used as an argument to a `Projection`'s or `Where`'s
+ * `operator()`. The attributes are embedded in the template arguments.
+ *
+ * This class is not the actual query but a class that serves as a tag for the
+ * other query classes.
+ * The query class is `GroupByQueryImpl`.
+ */
+template <auto Attr, auto... Attrs>
+struct GroupBy
+{
+};
+
+/** Having clause arguments.
+ *
+ * This class is used as an argument to a `GroupBy`'s `operator()`.
+ * The constructor takes as argument the condition to apply to the groups.
+ * Conditions are written as for `Where`, and may also use aggregates (such as
+ * `Sum<&Model::attr>{}`) as operands.
+ *
+ * The query class is `HavingQueryImpl`.
+ */
+template <typename Condition>
+struct Having
+{
+public:
+  constexpr Having(Condition&& c) noexcept : condition{std::move(c)}
+  {
+  }
+
+  Condition condition;
+};
+
+template <typename Query, typename Condition>
+class HavingQueryImpl;
+
+template <typename Query, typename Condition>
+using HavingQuery =
+    QueryContinuation<Query, HavingQueryImpl<Query, Condition>>;
+
+/** A Group by query.
+ *
+ * The class continues a `Projection` or `Where` query.
+ * Takes a `GroupBy` as argument.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ *
+ * The `operator()` can be used to continue the query (Having, OrderBy,
+ * Limit).
+ */
+template <typename Query, auto... Attrs>
+class GroupByQueryImpl
+{
+public:
+  using model_type = typename Query::model_type;
+  using table_type = typename Query::table_type;
+  using Table = table_type;
+
+  constexpr GroupByQueryImpl(MYSQL& mysql,
+                             Query q,
+                             Table const& t,
+                             GroupBy<Attrs...>&&) noexcept
+    : mysql_handle{&mysql}, query{std::move(q)}, table{&t}
+  {
+  }
+  constexpr GroupByQueryImpl(GroupByQueryImpl const& b) = default;
+  constexpr GroupByQueryImpl(GroupByQueryImpl&& b) noexcept = default;
+  ~GroupByQueryImpl() noexcept = default;
+
+  constexpr GroupByQueryImpl& operator=(GroupByQueryImpl const& rhs) = default;
+  constexpr GroupByQueryImpl& operator=(GroupByQueryImpl&& rhs) noexcept =
+      default;
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    return this->query.buildqueryCS() + " GROUP BY " +
+           details::ColumnNamesJoiner<Table, Attrs...>::join(*this->table);
+  }
+
+  template <typename Condition>
+  constexpr auto operator()(Having<Condition> having)
+  {
+    using ContinuationType = QueryContinuation<Query, GroupByQueryImpl>;
+    return HavingQuery<ContinuationType, Condition>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(having.condition)};
+  }
+
+  template <auto Attr, typename Direction>
+  constexpr auto operator()(OrderBy<Attr, Direction> order)
+  {
+    using ContinuationType = QueryContinuation<Query, GroupByQueryImpl>;
+    return OrderByQuery<ContinuationType, OrderBy<Attr, Direction>>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(order)};
+  }
+
+  template <typename Limit>
+  constexpr auto operator()(Limit limit)
+  {
+    using ContinuationType = QueryContinuation<Query, GroupByQueryImpl>;
+    return LimitQuery<ContinuationType, Limit>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(limit)};
+  }
+
+protected:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Query query;
+  Table const* table;
+};
+
+template <typename Query, typename GroupBy>
+struct GroupByQueryGetter;
+
+template <typename Query, auto... Attrs>
+struct GroupByQueryGetter<Query, GroupBy<Attrs...>>
+{
+  using type = QueryContinuation<Query, GroupByQueryImpl<Query, Attrs...>>;
+};
+
+template <typename Query, typename GroupBy>
+using GroupByQuery = typename GroupByQueryGetter<Query, GroupBy>::type;
+
+/** A Having query.
+ *
+ * The class continues a `GroupBy` query.
+ * Takes a condition as parameter, which must be an `OperatorClosure`.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ *
+ * The `operator()` can be used to continue the query (OrderBy, Limit).
+ */
+template <typename Query, typename Condition>
+class HavingQueryImpl
+{
+public:
+  using model_type = typename Query::model_type;
+  using table_type = typename Query::table_type;
+  using Table = table_type;
+
+  constexpr HavingQueryImpl(MYSQL& mysql,
+                            Query q,
+                            Table const& t,
+                            Condition&& c) noexcept
+    : mysql_handle{&mysql},
+      query{std::move(q)},
+      table{&t},
+      condition{std::move(c)}
+  {
+  }
+  constexpr HavingQueryImpl(HavingQueryImpl const& b) = default;
+  constexpr HavingQueryImpl(HavingQueryImpl&& b) noexcept = default;
+  ~HavingQueryImpl() noexcept = default;
+
+  constexpr HavingQueryImpl& operator=(HavingQueryImpl const& rhs) = default;
+  constexpr HavingQueryImpl& operator=(HavingQueryImpl&& rhs) noexcept =
+      default;
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    return this->condition.appendToQuery(
+        this->query.buildqueryCS() + " HAVING ", *this->table);
+  }
+
+  template <auto Attr, typename Direction>
+  constexpr auto operator()(OrderBy<Attr, Direction> order)
+  {
+    using ContinuationType = QueryContinuation<Query, HavingQueryImpl>;
+    return OrderByQuery<ContinuationType, OrderBy<Attr, Direction>>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(order)};
+  }
+
+  template <typename Limit>
+  constexpr auto operator()(Limit limit)
+  {
+    using ContinuationType = QueryContinuation<Query, HavingQueryImpl>;
+    return LimitQuery<ContinuationType, Limit>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(limit)};
+  }
+
+  static constexpr size_t getNbInputSlots() noexcept
+  {
+    return Query::getNbInputSlots() + Condition::getNbInputSlots();
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>& binds) const noexcept
+  {
+    this->query.bindInTo(binds);
+    this->condition.bindInTo(binds, this->query.getNbInputSlots());
+  }
+
+  template <std::size_t NBINDS>
+  void rebindStdTmReferences(InputBindArray<NBINDS>& ins) const noexcept
+  {
+    this->query.rebindStdTmReferences(ins);
+    this->condition.rebindStdTmReferences(ins, this->query.getNbInputSlots());
+  }
+
+protected:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Query query;
+  Table const* table;
+
+private:
+  Condition condition;
+};
+}
+
+#endif /* !MYSQL_ORM_GROUPBY_HPP_ */
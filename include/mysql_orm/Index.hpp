@@ -0,0 +1,247 @@
+#ifndef MYSQL_ORM_INDEX_HPP_
+#define MYSQL_ORM_INDEX_HPP_
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include <CompileString/CompileString.hpp>
+#include <CompileString/ToString.hpp>
+
+#include <mysql_orm/meta/AllSame.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/LiftOptional.hpp>
+#include <mysql_orm/meta/Pack.hpp>
+#include <mysql_orm/meta/TypeValEquals.hpp>
+
+namespace mysql_orm
+{
+enum class IndexKind
+{
+  Plain,
+  Unique,
+  PrimaryKey
+};
+
+/** Length of the prefix of a text attribute to index.
+ *
+ * Given as argument to `make_index`, `make_unique` or `make_primary_key`.
+ */
+template <auto Attr, std::size_t LENGTH>
+struct PrefixLength
+{
+  static_assert(LENGTH > 0, "Prefix length must not be 0");
+
+  static inline constexpr auto attribute = Attr;
+  static inline constexpr auto length = LENGTH;
+};
+
+namespace details
+{
+/** Metafunction returning the prefix length given to `Attr`, or 0.
+ */
+template <auto Attr, typename PrefixesPack>
+struct PrefixLengthOf;
+
+template <auto Attr, auto... PrefixAttrs, std::size_t... LENGTHS>
+struct PrefixLengthOf<Attr,
+                      meta::Pack<PrefixLength<PrefixAttrs, LENGTHS>...>>
+  : std::integral_constant<
+        std::size_t,
+        ((meta::TypeValEquals_v<Attr, PrefixAttrs> ? LENGTHS : 0) + ... + 0)>
+{
+};
+
+template <typename Field>
+inline constexpr auto is_text_field_v =
+    std::is_same_v<Field, std::string> || std::is_same_v<Field, char*> ||
+    std::is_same_v<Field, char const*>;
+}
+
+/** An index of a table.
+ *
+ * The index spans the attributes given in template arguments, in order.
+ * Users should not manipulate this class directly (see `make_index`).
+ *
+ * The class defines one member type:
+ *   - `attributes_type`: `meta::ValuePack` of the indexed attributes.
+ *
+ * The class defines two static members:
+ *   - `unique`: Whether the index is `UNIQUE` (or the primary key).
+ *   - `primary_key`: Whether the index is the primary key.
+ */
+template <IndexKind KIND,
+          std::size_t NAME_SIZE,
+          typename PrefixesPack,
+          auto Attr,
+          auto... Attrs>
+class Index
+{
+public:
+  using attributes_type = meta::ValuePack<Attr, Attrs...>;
+  static inline constexpr auto unique = KIND != IndexKind::Plain;
+  static inline constexpr auto primary_key = KIND == IndexKind::PrimaryKey;
+
+  constexpr explicit Index(char const (&name)[NAME_SIZE]) noexcept
+    : index_name{name}
+  {
+  }
+  constexpr Index(Index const& b) noexcept = default;
+  constexpr Index(Index&& b) noexcept = default;
+  ~Index() noexcept = default;
+
+  constexpr Index& operator=(Index const& rhs) noexcept = default;
+  constexpr Index& operator=(Index&& rhs) noexcept = default;
+
+  /** Returns the definition of the index, for use in `CREATE TABLE`.
+   */
+  template <typename Table>
+  constexpr auto getSchema(Table const& t) const
+  {
+    auto const parts =
+        '(' + PartsJoiner<Table, Attr, Attrs...>::join(t) + ')';
+    if constexpr (KIND == IndexKind::PrimaryKey)
+      return "PRIMARY KEY " + parts;
+    else if constexpr (KIND == IndexKind::Unique)
+      return "UNIQUE INDEX `" + this->index_name + "` " + parts;
+    else
+      return "INDEX `" + this->index_name + "` " + parts;
+  }
+
+  constexpr auto getName() const noexcept
+  {
+    return this->index_name;
+  }
+
+private:
+  template <std::size_t N>
+  using CompileString = compile_string::CompileString<N>;
+
+  /** Returns the column of the attribute, with its prefix length if any.
+   */
+  template <typename Table, auto PartAttr>
+  static constexpr auto partCS(Table const& t)
+  {
+    using Column_t = std::remove_cv_t<std::remove_reference_t<decltype(
+        t.template getColumn<PartAttr>())>>;
+    constexpr auto prefix_length =
+        details::PrefixLengthOf<PartAttr, PrefixesPack>::value;
+    constexpr auto is_text =
+        details::is_text_field_v<typename Column_t::lifted_field_type>;
+    static_assert(prefix_length == 0 || is_text,
+                  "Prefix lengths can only be used for text types");
+    static_assert(prefix_length > 0 || !is_text || Column_t::varchar_size > 0,
+                  "TEXT columns need a prefix length to be indexed");
+
+    auto const name = '`' + t.template getColumn<PartAttr>().getName() + '`';
+    if constexpr (prefix_length > 0)
+      return name + '(' + compile_string::toString<prefix_length>() + ')';
+    else
+      return name;
+  }
+
+  template <typename Table, auto PartAttr, auto... PartAttrs>
+  struct PartsJoiner
+  {
+    static constexpr auto join(Table const& t)
+    {
+      return partCS<Table, PartAttr>(t) + ", " +
+             PartsJoiner<Table, PartAttrs...>::join(t);
+    }
+  };
+
+  template <typename Table, auto PartAttr>
+  struct PartsJoiner<Table, PartAttr>
+  {
+    static constexpr auto join(Table const& t)
+    {
+      return partCS<Table, PartAttr>(t);
+    }
+  };
+
+  CompileString<NAME_SIZE - 1> index_name;
+};
+
+namespace details
+{
+template <IndexKind KIND,
+          auto Attr,
+          auto... Attrs,
+          std::size_t name_size,
+          typename... Prefixes>
+constexpr auto makeIndex(char const (&name)[name_size], Prefixes...)
+{
+  static_assert(
+      meta::AllSame_v<meta::AttributeModelGetter_t<decltype(Attr)>,
+                      meta::AttributeModelGetter_t<decltype(Attrs)>...>,
+      "Attributes do not refer to the same model");
+  static_assert(
+      (meta::ValuePackContains_v<Prefixes::attribute,
+                                 meta::ValuePack<Attr, Attrs...>> &&
+       ...),
+      "Prefix length given for an attribute that is not indexed");
+  return Index<KIND, name_size, meta::Pack<Prefixes...>, Attr, Attrs...>{
+      name};
+}
+
+template <typename T>
+struct IsIndex : std::false_type
+{
+};
+
+template <IndexKind KIND,
+          std::size_t NAME_SIZE,
+          typename PrefixesPack,
+          auto Attr,
+          auto... Attrs>
+struct IsIndex<Index<KIND, NAME_SIZE, PrefixesPack, Attr, Attrs...>>
+  : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr auto IsIndex_v = IsIndex<T>::value;
+}
+
+/** Helper functions to create an index.
+ *
+ * Used as `make_index<&Model::Field1, &Model::Field2>("index_name")`, and
+ * given to `make_table` along with the columns.
+ * Text columns are indexed on a prefix, given as
+ * `PrefixLength<&Model::Field2, 16>{}` after the name.
+ *
+ * `make_unique` creates a `UNIQUE` index, and `make_primary_key` the primary
+ * key of the table, which may then span several columns:
+ * `make_primary_key<&Model::Field1, &Model::Field2>()`.
+ */
+template <auto Attr,
+          auto... Attrs,
+          std::size_t name_size,
+          typename... Prefixes>
+constexpr auto make_index(char const (&name)[name_size],
+                          Prefixes... prefixes)
+{
+  return details::makeIndex<IndexKind::Plain, Attr, Attrs...>(name,
+                                                               prefixes...);
+}
+
+template <auto Attr,
+          auto... Attrs,
+          std::size_t name_size,
+          typename... Prefixes>
+constexpr auto make_unique(char const (&name)[name_size],
+                           Prefixes... prefixes)
+{
+  return details::makeIndex<IndexKind::Unique, Attr, Attrs...>(name,
+                                                                prefixes...);
+}
+
+template <auto Attr, auto... Attrs, typename... Prefixes>
+constexpr auto make_primary_key(Prefixes... prefixes)
+{
+  return details::makeIndex<IndexKind::PrimaryKey, Attr, Attrs...>(
+      "", prefixes...);
+}
+}
+
+#endif /* !MYSQL_ORM_INDEX_HPP_ */
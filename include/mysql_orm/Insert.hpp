@@ -1,12 +1,16 @@
 #ifndef MYSQL_ORM_INSERT_HPP_
 #define MYSQL_ORM_INSERT_HPP_
 
+#include <cstddef>
 #include <functional>
 #include <sstream>
+#include <string_view>
 
 #include <mysql/mysql.h>
 
+#include <mysql_orm/BindArray.hpp>
 #include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/SQLText.hpp>
 #include <mysql_orm/Statement.hpp>
 #include <mysql_orm/meta/AttributePtrDissector.hpp>
 
@@ -22,8 +26,12 @@ public:
 
   constexpr Insert(MYSQL& mysql,
                    Table const& t,
-                   model_type const* to_insert) noexcept
-    : mysql_handle{&mysql}, table{&t}, model_to_insert{to_insert}
+                   model_type const* to_insert,
+                   StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql},
+      table{&t},
+      model_to_insert{to_insert},
+      stmt_cache{cache}
   {
   }
   constexpr Insert(Insert const& b) noexcept = default;
@@ -38,9 +46,14 @@ public:
     return this->build().execute();
   }
 
-  constexpr auto buildquery() const
+  std::string_view buildquery() const
   {
-    return this->buildqueryCS();
+    return details::SQLText<Insert>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
   }
 
   constexpr auto buildqueryCS() const
@@ -56,26 +69,41 @@ public:
     return stmt;
   }
 
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
   constexpr static size_t getNbInputSlots() noexcept
   {
     return sizeof...(Attrs);
   }
 
+  /** Returns the number of input slots holding times.
+   */
+  constexpr static size_t getNbInputTimeSlots() noexcept
+  {
+    return details::countTimes<
+        meta::AttributeGetter_t<decltype(Attrs)>...>();
+  }
+
   constexpr static size_t getNbOutputSlots() noexcept
   {
     return 0;
   }
 
-  template <std::size_t NBINDS>
-  void bindInsert(model_type const& model, InputBindArray<NBINDS>& binds) const
-      noexcept
+  template <std::size_t NBINDS, std::size_t NTIMES>
+  void bindInsert(model_type const& model,
+                  InputBindArray<NBINDS, NTIMES>& binds) const noexcept
   {
     auto i = std::size_t{0};
-    (binds.bind(i++, model.*Attrs), ...);
+    auto time_idx = std::size_t{0};
+    (binds.bind(i++, model.*Attrs, time_idx), ...);
   }
 
-  template <std::size_t NBINDS>
-  constexpr void rebindStdTmReferences(InputBindArray<NBINDS>&) const noexcept
+  template <std::size_t NBINDS, std::size_t NTIMES>
+  constexpr void rebindStdTmReferences(InputBindArray<NBINDS, NTIMES>&) const
+      noexcept
   {
   }
 
@@ -85,6 +113,135 @@ private:
   MYSQL* mysql_handle;
   Table const* table;
   model_type const* model_to_insert;
+  StatementCache* stmt_cache;
+};
+
+namespace details
+{
+/** Maximum number of placeholders of a batch insert.
+ *
+ * The binds of a statement are on the stack, and a `MYSQL_BIND` takes about
+ * 112 bytes: this keeps them under half a megabyte, well below the 65535
+ * placeholders the server accepts.
+ */
+inline constexpr std::size_t max_insert_batch_slots{4096};
+}
+
+/** Number of rows inserted per query when inserting a range of models.
+ *
+ * This class is used as an argument to `Database::insert` and serves as a
+ * tag. Batches may have at most `details::max_insert_batch_slots` values.
+ */
+template <std::size_t nrows = 64>
+struct BatchSize
+{
+  static_assert(nrows > 0, "Batch size must not be 0");
+  static inline constexpr std::size_t value{nrows};
+};
+
+/** An INSERT query for `NROWS` models at once.
+ *
+ * The query has `NROWS` lists of values. Models are bound with
+ * `bindInsertRange`, which binds the attributes of the models in place: they
+ * must outlive the execution of the statement.
+ */
+template <typename Table, std::size_t NROWS, auto... Attrs>
+class InsertBatch
+{
+public:
+  using model_type = typename Table::model_type;
+  using table_type = Table;
+  static inline constexpr auto query_type{QueryType::Insert};
+
+  static_assert(NROWS * sizeof...(Attrs) <= details::max_insert_batch_slots,
+                "Too many placeholders in a single statement");
+
+  constexpr InsertBatch(MYSQL& mysql,
+                        Table const& t,
+                        StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
+  {
+  }
+  constexpr InsertBatch(InsertBatch const& b) noexcept = default;
+  constexpr InsertBatch(InsertBatch&& b) noexcept = default;
+  ~InsertBatch() noexcept = default;
+
+  InsertBatch& operator=(InsertBatch const& rhs) noexcept = default;
+  InsertBatch& operator=(InsertBatch&& rhs) noexcept = default;
+
+  std::string_view buildquery() const
+  {
+    return details::SQLText<InsertBatch>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
+  }
+
+  constexpr auto buildqueryCS() const
+  {
+    return this->table->template insertBatchCS<NROWS, Attrs...>();
+  }
+
+  constexpr Statement<InsertBatch, model_type> build() const
+  {
+    return Statement<InsertBatch, model_type>{*this->mysql_handle, *this};
+  }
+
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
+  constexpr static size_t getNbInputSlots() noexcept
+  {
+    return NROWS * sizeof...(Attrs);
+  }
+
+  /** Returns the number of input slots holding times.
+   *
+   * Only these slots have a `MYSQL_TIME` in the input binds, which would
+   * otherwise take 40 bytes per placeholder.
+   */
+  constexpr static size_t getNbInputTimeSlots() noexcept
+  {
+    return NROWS *
+           details::countTimes<meta::AttributeGetter_t<decltype(Attrs)>...>();
+  }
+
+  constexpr static size_t getNbOutputSlots() noexcept
+  {
+    return 0;
+  }
+
+  /** Binds the `NROWS` models starting at `first`.
+   */
+  template <typename Iterator, std::size_t NBINDS, std::size_t NTIMES>
+  void bindInsertRange(Iterator first,
+                       InputBindArray<NBINDS, NTIMES>& binds) const
+  {
+    auto i = std::size_t{0};
+    auto time_idx = std::size_t{0};
+    for (auto row = std::size_t{0}; row < NROWS; ++row, ++first)
+    {
+      auto const& model = *first;
+      (binds.bind(i++, model.*Attrs, time_idx), ...);
+    }
+  }
+
+  template <std::size_t NBINDS, std::size_t NTIMES>
+  constexpr void rebindStdTmReferences(InputBindArray<NBINDS, NTIMES>&) const
+      noexcept
+  {
+  }
+
+private:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Table const* table;
+  StatementCache* stmt_cache;
 };
 }
 
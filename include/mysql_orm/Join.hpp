@@ -0,0 +1,297 @@
+#ifndef MYSQL_ORM_JOIN_HPP_
+#define MYSQL_ORM_JOIN_HPP_
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/ColumnNamesJoiner.hpp>
+#include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
+#include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/RowStream.hpp>
+#include <mysql_orm/SQLText.hpp>
+#include <mysql_orm/Statement.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/Where.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/Pack.hpp>
+
+namespace mysql_orm
+{
+/** Join condition.
+ *
+ * This class is used as an argument to `Database::join`.
+ * Conditions are written as for `Where`, and may refer to the attributes of
+ * both models.
+ */
+template <typename Condition>
+struct On
+{
+public:
+  constexpr On(Condition&& c) noexcept : condition{std::move(c)}
+  {
+  }
+
+  Condition condition;
+};
+
+/** Column of a table, whose name is qualified with the name of the table.
+ */
+template <typename Table, typename Column>
+class QualifiedColumn
+{
+public:
+  static inline constexpr auto varchar_size{Column::varchar_size};
+
+  constexpr QualifiedColumn(Table const& t, Column const& c) noexcept
+    : table{&t}, column{&c}
+  {
+  }
+
+  /** Returns "table`.`column", to be enclosed in backquotes.
+   */
+  constexpr auto getName() const noexcept
+  {
+    return this->table->getName() + "`.`" + this->column->getName();
+  }
+
+private:
+  Table const* table;
+  Column const* column;
+};
+
+/** Two joined tables.
+ *
+ * The class is used as the table of `Join` queries, and resolves attributes
+ * of both models to qualified columns. Conditions and clauses continuing a
+ * join thus refer to `table`.`column`.
+ *
+ * Tables are copied, so that the object does not depend on the lifetime of
+ * the database that made it.
+ */
+template <typename TableA, typename TableB>
+class JoinedTables
+{
+public:
+  using model_type = std::pair<typename TableA::model_type,
+                               typename TableB::model_type>;
+  using table_a_attributes_type = typename TableA::attributes_type;
+  using table_b_attributes_type = typename TableB::attributes_type;
+
+  constexpr JoinedTables(TableA const& a, TableB const& b)
+    : table_a{a}, table_b{b}
+  {
+  }
+
+  template <auto Attr>
+  auto getColumn() const noexcept
+  {
+    using Model_t = meta::AttributeModelGetter_t<decltype(Attr)>;
+    static_assert(std::is_same_v<Model_t, typename TableA::model_type> ||
+                      std::is_same_v<Model_t, typename TableB::model_type>,
+                  "Attribute does not refer to a joined model");
+    auto const& table = this->getTable<Model_t>();
+    auto const& column = table.template getColumn<Attr>();
+    return QualifiedColumn<std::remove_reference_t<decltype(table)>,
+                           std::remove_reference_t<decltype(column)>>{
+        table, column};
+  }
+
+  constexpr TableA const& getTableA() const noexcept
+  {
+    return this->table_a;
+  }
+
+  constexpr TableB const& getTableB() const noexcept
+  {
+    return this->table_b;
+  }
+
+  constexpr bool hasSameNames(JoinedTables const& b) const noexcept
+  {
+    return this->table_a.hasSameNames(b.table_a) &&
+           this->table_b.hasSameNames(b.table_b);
+  }
+
+private:
+  template <typename Model>
+  constexpr auto const& getTable() const noexcept
+  {
+    if constexpr (std::is_same_v<Model, typename TableA::model_type>)
+      return this->table_a;
+    else
+      return this->table_b;
+  }
+
+  TableA table_a;
+  TableB table_b;
+};
+
+template <typename Joined,
+          typename Condition,
+          typename AttributesA = typename Joined::table_a_attributes_type,
+          typename AttributesB = typename Joined::table_b_attributes_type>
+class Join;
+
+/** An inner join query.
+ *
+ * Selects all columns of both tables, with an `INNER JOIN ... ON` clause.
+ * Rows are `std::pair`s of models.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ * `stream` returns a `RowStream`, which fetches rows one at a time.
+ *
+ * The `operator()` can be used to continue the query (Where, OrderBy, Limit).
+ */
+template <typename Joined, typename Condition, auto... As, auto... Bs>
+class Join<Joined, Condition, meta::ValuePack<As...>, meta::ValuePack<Bs...>>
+{
+public:
+  using table_type = Joined;
+  using model_type = typename Joined::model_type;
+  static inline constexpr auto query_type{QueryType::GetAll};
+
+  constexpr Join(MYSQL& mysql,
+                 Joined const& t,
+                 Condition&& c,
+                 StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql},
+      table{&t},
+      condition{std::move(c)},
+      stmt_cache{cache}
+  {
+  }
+  constexpr Join(Join const& b) = default;
+  constexpr Join(Join&& b) noexcept = default;
+  ~Join() noexcept = default;
+
+  constexpr Join& operator=(Join const& rhs) = default;
+  constexpr Join& operator=(Join&& rhs) noexcept = default;
+
+  template <typename WCondition>
+  constexpr WhereQuery<Join, WCondition> operator()(Where<WCondition> where)
+  {
+    return WhereQuery<Join, WCondition>{
+        *this->mysql_handle, *this, *this->table, std::move(where.condition)};
+  }
+
+  template <auto Attr, typename Direction>
+  constexpr OrderByQuery<Join, OrderBy<Attr, Direction>> operator()(
+      OrderBy<Attr, Direction> order)
+  {
+    return OrderByQuery<Join, OrderBy<Attr, Direction>>{
+        *this->mysql_handle, *this, *this->table, std::move(order)};
+  }
+
+  template <typename Limit>
+  constexpr LimitQuery<Join, Limit> operator()(Limit limit)
+  {
+    return LimitQuery<Join, Limit>{
+        *this->mysql_handle, *this, *this->table, std::move(limit)};
+  }
+
+  auto operator()()
+  {
+    return this->build().execute();
+  }
+
+  RowStream<Join, model_type> stream() const
+  {
+    return RowStream<Join, model_type>{*this};
+  }
+
+  std::string_view buildquery() const
+  {
+    return details::SQLText<Join>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
+  }
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    return this->condition.appendToQuery(
+        "SELECT " +
+            details::ColumnNamesJoiner<Joined, As..., Bs...>::join(
+                *this->table) +
+            " FROM `" + this->table->getTableA().getName() +
+            "` INNER JOIN `" + this->table->getTableB().getName() + "` ON ",
+        *this->table);
+  }
+
+  constexpr Statement<Join, model_type> build() const
+  {
+    return Statement<Join, model_type>{*this->mysql_handle, *this};
+  }
+
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
+  constexpr static size_t getNbInputSlots() noexcept
+  {
+    return Condition::getNbInputSlots();
+  }
+
+  constexpr static size_t getNbOutputSlots() noexcept
+  {
+    return sizeof...(As) + sizeof...(Bs);
+  }
+
+  template <std::size_t NBINDS>
+  void bindOutTo(model_type& model, OutputBindArray<NBINDS>& binds) const
+  {
+    auto i = std::size_t{0};
+    (binds.template bind<decltype(
+         this->table->template getColumn<As>())::varchar_size>(
+         i++, model.first.*As),
+     ...);
+    (binds.template bind<decltype(
+         this->table->template getColumn<Bs>())::varchar_size>(
+         i++, model.second.*Bs),
+     ...);
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>& binds) const noexcept
+  {
+    this->condition.bindInTo(binds, 0);
+  }
+
+  template <std::size_t NBINDS>
+  void rebindStdTmReferences(InputBindArray<NBINDS>& ins) const noexcept
+  {
+    this->condition.rebindStdTmReferences(ins, 0);
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void finalizeBindings(MYSQL_STMT& stmt,
+                                  model_type const& bound,
+                                  model_type& model,
+                                  OutputBindArray<NBINDS>& binds)
+  {
+    auto i = std::size_t{0};
+    (binds.finalize(stmt, i++, bound.first.*As, model.first.*As), ...);
+    (binds.finalize(stmt, i++, bound.second.*Bs, model.second.*Bs), ...);
+  }
+
+private:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Joined const* table;
+  Condition condition;
+  StatementCache* stmt_cache;
+};
+}
+
+#endif /* !MYSQL_ORM_JOIN_HPP_ */
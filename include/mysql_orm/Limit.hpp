@@ -4,44 +4,18 @@
 #include <cstddef>
 #include <functional>
 #include <sstream>
+#include <type_traits>
 
 #include <CompileString/CompileString.hpp>
 #include <CompileString/ToString.hpp>
 #include <mysql/mysql.h>
 
+#include <mysql_orm/BindArray.hpp>
 #include <mysql_orm/QueryContinuation.hpp>
+#include <mysql_orm/QueryType.hpp>
 
 namespace mysql_orm
 {
-namespace details
-{
-constexpr unsigned int ulog10(std::size_t n)
-{
-  auto log = 0u;
-
-  while (n > 10)
-  {
-    ++log;
-    n /= 10;
-  }
-
-  return log;
-}
-
-constexpr auto toBigEnoughCS(std::size_t n) noexcept
-{
-  constexpr auto retlen = ulog10(std::numeric_limits<std::size_t>::max());
-  auto ret = compile_string::CompileString<retlen>{
-      compile_string::CompileString<0>{""}};
-  for (auto i = std::size_t{0}; i < retlen - 1; ++i)
-    ret[i] = ' ';
-  ret[retlen - 1] = '0';
-  for (auto i = retlen; i > 0 && n > 0; ++i, n /= 10)
-    ret[i - 1] = '0' + n % 10;
-  return ret;
-}
-}
-
 /** Limit clause arguments.
  *
  * This class is used as an argument to a `Select`'s or `Where`'s `operator()`
@@ -65,13 +39,47 @@ struct Limit<0>
   size_t const value{0};
 };
 
+/** Offset clause arguments.
+ *
+ * This class is used as an argument to a `Limit`'s `operator()`, since MySQL
+ * only accepts an offset after a limit.
+ * The offset is embedded in the template argument.
+ * If the offset is set to 0, a runtime value may be supplied upon
+ * initialization.
+ *
+ * This class is not the actual query but a class that serves as a tag for the
+ * other query classes.
+ * The query class is `OffsetQueryImpl`.
+ */
+template <size_t offset = 0>
+struct Offset
+{
+  static inline constexpr size_t value{offset};
+};
+
+template <>
+struct Offset<0>
+{
+  size_t const value{0};
+};
+
+template <typename Query, typename TOffset>
+class OffsetQueryImpl;
+
+template <typename Query, typename Offset>
+using OffsetQuery = QueryContinuation<Query, OffsetQueryImpl<Query, Offset>>;
+
 /** A Limit query.
  *
  * The class continues a `Select` or `Where` query.
  * Takes a limit as argument, which must be a `Limit`.
+ * Runtime limits are bound as a statement parameter, so that the SQL text does
+ * not depend on their value.
  *
- * `buildquery` returns the SQL query as a std::string.
+ * `buildquery` returns a view of the SQL query.
  * `build` returns a `Statement`, which can later be `execute()`d.
+ *
+ * The `operator()` can be used to continue the query (Offset).
  */
 template <typename Query, typename TLimit>
 class LimitQueryImpl
@@ -81,6 +89,8 @@ public:
   using table_type = typename Query::table_type;
   using Table = table_type;
 
+  static inline constexpr bool is_runtime{std::is_same_v<TLimit, Limit<0>>};
+
   LimitQueryImpl(MYSQL& mysql, Query q, Table const& t, TLimit&& l) noexcept
     : mysql_handle{&mysql}, query{std::move(q)}, table{&t}, limit{std::move(l)}
   {
@@ -94,13 +104,37 @@ public:
 
   auto buildqueryCS() const
   {
-    /// XXX(ethiraric): Use the real limit!!!
-    if constexpr (!std::is_same_v<TLimit, Limit<0>>)
+    if constexpr (!is_runtime)
       return this->query.buildqueryCS() + " LIMIT " +
              compile_string::toString<TLimit::value>();
     else
-      return this->query.buildqueryCS() + " LIMIT " +
-             details::toBigEnoughCS(limit.value);
+      return this->query.buildqueryCS() + " LIMIT ?";
+  }
+
+  template <std::size_t N>
+  constexpr auto operator()(Offset<N> offset)
+  {
+    using ContinuationType = QueryContinuation<Query, LimitQueryImpl>;
+    static_assert(ContinuationType::query_type == QueryType::GetAll,
+                  "Only GetAll queries can have an offset");
+    return OffsetQuery<ContinuationType, Offset<N>>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(offset)};
+  }
+
+  static constexpr size_t getNbInputSlots() noexcept
+  {
+    return Query::getNbInputSlots() + (is_runtime ? 1 : 0);
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>& binds) const noexcept
+  {
+    this->query.bindInTo(binds);
+    if constexpr (is_runtime)
+      binds.bind(Query::getNbInputSlots(), this->limit.value);
   }
 
 protected:
@@ -114,6 +148,72 @@ private:
   TLimit limit;
 };
 
+/** An Offset query.
+ *
+ * The class continues a `Limit` query on a `Select`.
+ * Takes an offset as argument, which must be an `Offset`.
+ * Runtime offsets are bound as a statement parameter.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ */
+template <typename Query, typename TOffset>
+class OffsetQueryImpl
+{
+public:
+  using model_type = typename Query::model_type;
+  using table_type = typename Query::table_type;
+  using Table = table_type;
+
+  static inline constexpr bool is_runtime{std::is_same_v<TOffset, Offset<0>>};
+
+  OffsetQueryImpl(MYSQL& mysql, Query q, Table const& t, TOffset&& o) noexcept
+    : mysql_handle{&mysql},
+      query{std::move(q)},
+      table{&t},
+      offset{std::move(o)}
+  {
+  }
+  OffsetQueryImpl(OffsetQueryImpl const& b) = default;
+  OffsetQueryImpl(OffsetQueryImpl&& b) noexcept = default;
+  ~OffsetQueryImpl() noexcept = default;
+
+  OffsetQueryImpl& operator=(OffsetQueryImpl const& rhs) = default;
+  OffsetQueryImpl& operator=(OffsetQueryImpl&& rhs) noexcept = default;
+
+  auto buildqueryCS() const
+  {
+    if constexpr (!is_runtime)
+      return this->query.buildqueryCS() + " OFFSET " +
+             compile_string::toString<TOffset::value>();
+    else
+      return this->query.buildqueryCS() + " OFFSET ?";
+  }
+
+  static constexpr size_t getNbInputSlots() noexcept
+  {
+    return Query::getNbInputSlots() + (is_runtime ? 1 : 0);
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>& binds) const noexcept
+  {
+    this->query.bindInTo(binds);
+    if constexpr (is_runtime)
+      binds.bind(Query::getNbInputSlots(), this->offset.value);
+  }
+
+protected:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Query query;
+  Table const* table;
+
+private:
+  TOffset offset;
+};
+
 template <typename Query, typename Limit>
 using LimitQuery = QueryContinuation<Query, LimitQueryImpl<Query, Limit>>;
 }
@@ -0,0 +1,354 @@
+#ifndef MYSQL_ORM_METRICS_HPP_
+#define MYSQL_ORM_METRICS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mysql_orm
+{
+/** Whether statements record metrics.
+ *
+ * Define `MYSQL_ORM_NO_METRICS` to compile instrumentation out of
+ * statements. A `MetricsRegistry` may then still be set, but records nothing.
+ */
+#ifdef MYSQL_ORM_NO_METRICS
+inline constexpr bool metrics_enabled{false};
+#else
+inline constexpr bool metrics_enabled{true};
+#endif
+
+/** Phases of the life of a statement.
+ */
+enum class Phase : std::size_t
+{
+  // Preparing the statement on the server (on cache misses).
+  Prepare,
+  // Binding parameters and results.
+  Bind,
+  // Executing the statement, up to the first row.
+  Execute,
+  // Fetching rows.
+  Fetch,
+  // Decoding rows into models (`finalizeBindings`).
+  Decode
+};
+
+inline constexpr std::size_t nb_phases{5};
+
+/** Returns the 64-bit FNV-1a hash of `s`.
+ *
+ * Used to identify query shapes by their SQL text.
+ */
+constexpr std::uint64_t fnv1a(std::string_view s) noexcept
+{
+  auto hash = std::uint64_t{0xcbf29ce484222325};
+  for (auto c : s)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= std::uint64_t{0x100000001b3};
+  }
+  return hash;
+}
+
+/** Values of a histogram, at some point in time.
+ */
+struct HistogramSnapshot
+{
+  // Number of values in each bucket (see `Histogram`).
+  std::vector<std::uint64_t> buckets;
+  std::uint64_t count{0};
+  std::uint64_t sum{0};
+  std::uint64_t max{0};
+
+  /** Returns an upper bound of the `p`th percentile (`p` in [0, 1]).
+   *
+   * The bound is within 12.5% of the actual value.
+   */
+  std::uint64_t percentile(double p) const noexcept;
+
+  void merge(HistogramSnapshot const& b)
+  {
+    if (this->buckets.size() < b.buckets.size())
+      this->buckets.resize(b.buckets.size());
+    for (auto i = std::size_t{0}; i < b.buckets.size(); ++i)
+      this->buckets[i] += b.buckets[i];
+    this->count += b.count;
+    this->sum += b.sum;
+    this->max = std::max(this->max, b.max);
+  }
+};
+
+/** Histogram of durations in nanoseconds, with log-linear buckets.
+ *
+ * As in HDR histograms, values are grouped by power of two, and each power of
+ * two is split in `sub_buckets` linear buckets. This bounds the relative
+ * error, whatever the magnitude of values.
+ *
+ * Values are recorded with relaxed atomic operations, so that `record` never
+ * blocks and snapshots may be taken concurrently.
+ */
+class Histogram
+{
+public:
+  static inline constexpr std::size_t sub_bucket_bits{3};
+  static inline constexpr std::size_t sub_buckets{1u << sub_bucket_bits};
+  static inline constexpr std::size_t nb_buckets{(64 - sub_bucket_bits + 1) *
+                                                 sub_buckets};
+
+  Histogram() noexcept : buckets{}, count{0}, sum{0}, max{0}
+  {
+  }
+
+  Histogram(Histogram const& b) = delete;
+  Histogram& operator=(Histogram const& rhs) = delete;
+
+  void record(std::uint64_t value) noexcept
+  {
+    this->buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    this->count.fetch_add(1, std::memory_order_relaxed);
+    this->sum.fetch_add(value, std::memory_order_relaxed);
+    auto prev = this->max.load(std::memory_order_relaxed);
+    while (prev < value && !this->max.compare_exchange_weak(
+                               prev, value, std::memory_order_relaxed))
+      ;
+  }
+
+  HistogramSnapshot snapshot() const
+  {
+    auto ret = HistogramSnapshot{};
+    ret.buckets.resize(nb_buckets);
+    for (auto i = std::size_t{0}; i < nb_buckets; ++i)
+      ret.buckets[i] = this->buckets[i].load(std::memory_order_relaxed);
+    ret.count = this->count.load(std::memory_order_relaxed);
+    ret.sum = this->sum.load(std::memory_order_relaxed);
+    ret.max = this->max.load(std::memory_order_relaxed);
+    return ret;
+  }
+
+  /** Returns the bucket of `value`.
+   *
+   * Values lower than `sub_buckets` have a bucket of their own. Others are
+   * bucketed by their most significant bit, then by the `sub_bucket_bits`
+   * bits following it.
+   */
+  static constexpr std::size_t bucketOf(std::uint64_t value) noexcept
+  {
+    if (value < sub_buckets)
+      return static_cast<std::size_t>(value);
+    auto msb = std::size_t{0};
+    for (auto v = value; v > 1; v >>= 1)
+      ++msb;
+    auto const shift = msb - sub_bucket_bits;
+    auto const sub = static_cast<std::size_t>(value >> shift) - sub_buckets;
+    return (shift + 1) * sub_buckets + sub;
+  }
+
+  /** Returns the highest value of bucket `idx`.
+   */
+  static constexpr std::uint64_t bucketUpperBound(std::size_t idx) noexcept
+  {
+    if (idx < sub_buckets)
+      return idx;
+    auto const shift = idx / sub_buckets - 1;
+    auto const sub = idx % sub_buckets + sub_buckets;
+    return ((std::uint64_t{sub} + 1) << shift) - 1;
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, nb_buckets> buckets;
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::uint64_t> sum;
+  std::atomic<std::uint64_t> max;
+};
+
+inline std::uint64_t HistogramSnapshot::percentile(double p) const noexcept
+{
+  if (this->count == 0)
+    return 0;
+  auto const rank = static_cast<std::uint64_t>(p * (this->count - 1)) + 1;
+  auto seen = std::uint64_t{0};
+  for (auto i = std::size_t{0}; i < this->buckets.size(); ++i)
+  {
+    seen += this->buckets[i];
+    if (seen >= rank)
+      return std::min(Histogram::bucketUpperBound(i), this->max);
+  }
+  return this->max;
+}
+
+/** Metrics of one query shape, recorded by one thread.
+ */
+struct ShapeMetrics
+{
+  explicit ShapeMetrics(std::string_view s) : sql{s}
+  {
+  }
+
+  std::string const sql;
+  std::array<Histogram, nb_phases> phases;
+  std::atomic<std::uint64_t> rows{0};
+  std::atomic<std::uint64_t> bytes{0};
+};
+
+/** Metrics of one query shape, over all threads.
+ */
+struct ShapeSnapshot
+{
+  std::uint64_t shape{0};
+  std::string sql;
+  // Durations in nanoseconds, indexed by `Phase`.
+  std::array<HistogramSnapshot, nb_phases> phases;
+  std::uint64_t rows{0};
+  std::uint64_t bytes{0};
+
+  HistogramSnapshot const& operator[](Phase phase) const noexcept
+  {
+    return this->phases[static_cast<std::size_t>(phase)];
+  }
+};
+
+/** Collects the metrics of statements, per query shape.
+ *
+ * Each thread records into metrics of its own, so that recording is
+ * lock-free. `snapshot` merges the metrics of all threads.
+ *
+ * The registry is set on a `StatementCache` (see `Database::setMetrics`),
+ * and may be shared by several caches. It must outlive the statements that
+ * record into it.
+ */
+class MetricsRegistry
+{
+public:
+  MetricsRegistry() : id{next_id.fetch_add(1)}, mutex{}, threads{}
+  {
+  }
+
+  MetricsRegistry(MetricsRegistry const& b) = delete;
+  MetricsRegistry(MetricsRegistry&& b) = delete;
+  ~MetricsRegistry() noexcept = default;
+
+  MetricsRegistry& operator=(MetricsRegistry const& rhs) = delete;
+  MetricsRegistry& operator=(MetricsRegistry&& rhs) = delete;
+
+  /** Returns the metrics of `shape` for the calling thread.
+   *
+   * Statements call this once, and then record into the metrics directly.
+   */
+  ShapeMetrics& getShapeMetrics(std::uint64_t shape, std::string_view sql)
+  {
+    auto& thread = this->getThreadMetrics();
+    auto lock = std::lock_guard{thread.mutex};
+    auto& metrics = thread.shapes[shape];
+    if (!metrics)
+      metrics = std::make_unique<ShapeMetrics>(sql);
+    return *metrics;
+  }
+
+  /** Returns the metrics of all shapes, merged over all threads.
+   */
+  std::vector<ShapeSnapshot> snapshot() const
+  {
+    auto merged = std::map<std::uint64_t, ShapeSnapshot>{};
+    auto lock = std::lock_guard{this->mutex};
+    for (auto const& thread : this->threads)
+    {
+      auto thread_lock = std::lock_guard{thread->mutex};
+      for (auto const& [shape, metrics] : thread->shapes)
+      {
+        auto& snap = merged[shape];
+        snap.shape = shape;
+        if (snap.sql.empty())
+          snap.sql = metrics->sql;
+        for (auto i = std::size_t{0}; i < nb_phases; ++i)
+          snap.phases[i].merge(metrics->phases[i].snapshot());
+        snap.rows += metrics->rows.load(std::memory_order_relaxed);
+        snap.bytes += metrics->bytes.load(std::memory_order_relaxed);
+      }
+    }
+    auto ret = std::vector<ShapeSnapshot>{};
+    ret.reserve(merged.size());
+    for (auto& [shape, snap] : merged)
+      ret.push_back(std::move(snap));
+    return ret;
+  }
+
+private:
+  struct ThreadMetrics
+  {
+    // Only locked when adding a shape, and by `snapshot`.
+    std::mutex mutex;
+    std::unordered_map<std::uint64_t, std::unique_ptr<ShapeMetrics>> shapes;
+  };
+
+  ThreadMetrics& getThreadMetrics()
+  {
+    // Keyed by id rather than address, since a registry may be allocated
+    // where a destroyed one was.
+    thread_local auto per_registry =
+        std::unordered_map<std::uint64_t, ThreadMetrics*>{};
+    auto& thread = per_registry[this->id];
+    if (!thread)
+    {
+      auto lock = std::lock_guard{this->mutex};
+      thread = this->threads.emplace_back(std::make_unique<ThreadMetrics>())
+                   .get();
+    }
+    return *thread;
+  }
+
+  static inline std::atomic<std::uint64_t> next_id{0};
+
+  std::uint64_t const id;
+  mutable std::mutex mutex;
+  // Metrics of threads are kept after they exit, until the registry dies.
+  std::vector<std::unique_ptr<ThreadMetrics>> threads;
+};
+
+namespace details
+{
+/** Records the duration of its scope into a phase of the metrics, if any.
+ */
+class PhaseTimer
+{
+public:
+  PhaseTimer(ShapeMetrics* m, Phase p) noexcept
+    : metrics{metrics_enabled ? m : nullptr}, phase{p}, start{}
+  {
+    if (this->metrics)
+      this->start = std::chrono::steady_clock::now();
+  }
+
+  PhaseTimer(PhaseTimer const& b) = delete;
+  PhaseTimer& operator=(PhaseTimer const& rhs) = delete;
+
+  ~PhaseTimer() noexcept
+  {
+    if (!this->metrics)
+      return;
+    auto const elapsed = std::chrono::steady_clock::now() - this->start;
+    this->metrics->phases[static_cast<std::size_t>(this->phase)].record(
+        static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()));
+  }
+
+private:
+  ShapeMetrics* metrics;
+  Phase phase;
+  std::chrono::steady_clock::time_point start;
+};
+}
+}
+
+#endif /* !MYSQL_ORM_METRICS_HPP_ */
@@ -0,0 +1,115 @@
+#ifndef MYSQL_ORM_ORDERBY_HPP_
+#define MYSQL_ORM_ORDERBY_HPP_
+
+#include <type_traits>
+#include <utility>
+
+#include <CompileString/CompileString.hpp>
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Limit.hpp>
+#include <mysql_orm/QueryContinuation.hpp>
+
+namespace mysql_orm
+{
+/** Ascending order, for `OrderBy`.
+ */
+struct Asc
+{
+};
+
+/** Descending order, for `OrderBy`.
+ */
+struct Desc
+{
+};
+
+/** Order by clause arguments.
+ *
+ * This class is used as an argument to a `Select`'s or `Where`'s `operator()`.
+ * The attribute and direction are embedded in the template arguments.
+ *
+ * This class is not the actual query but a class that serves as a tag for the
+ * other query classes.
+ * The query class is `OrderByQueryImpl`.
+ */
+template <auto Attr, typename Direction = Asc>
+struct OrderBy
+{
+  static_assert(std::is_same_v<Direction, Asc> ||
+                    std::is_same_v<Direction, Desc>,
+                "Direction must be Asc or Desc");
+
+  static inline constexpr auto attribute{Attr};
+  using direction = Direction;
+};
+
+/** An Order by query.
+ *
+ * The class continues a `Select` or `Where` query.
+ * Takes an `OrderBy` as argument.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ *
+ * The `operator()` can be used to continue the query (Limit).
+ */
+template <typename Query, typename TOrderBy>
+class OrderByQueryImpl
+{
+public:
+  using model_type = typename Query::model_type;
+  using table_type = typename Query::table_type;
+  using Table = table_type;
+
+  constexpr OrderByQueryImpl(MYSQL& mysql,
+                             Query q,
+                             Table const& t,
+                             TOrderBy&&) noexcept
+    : mysql_handle{&mysql}, query{std::move(q)}, table{&t}
+  {
+  }
+  constexpr OrderByQueryImpl(OrderByQueryImpl const& b) = default;
+  constexpr OrderByQueryImpl(OrderByQueryImpl&& b) noexcept = default;
+  ~OrderByQueryImpl() noexcept = default;
+
+  constexpr OrderByQueryImpl& operator=(OrderByQueryImpl const& rhs) = default;
+  constexpr OrderByQueryImpl& operator=(OrderByQueryImpl&& rhs) noexcept =
+      default;
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    auto const ordered =
+        this->query.buildqueryCS() + " ORDER BY `" +
+        this->table->template getColumn<TOrderBy::attribute>().getName() + "`";
+    if constexpr (std::is_same_v<typename TOrderBy::direction, Desc>)
+      return ordered + " DESC";
+    else
+      return ordered + " ASC";
+  }
+
+  template <typename Limit>
+  constexpr auto operator()(Limit limit)
+  {
+    using ContinuationType = QueryContinuation<Query, OrderByQueryImpl>;
+    return LimitQuery<ContinuationType, Limit>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(limit)};
+  }
+
+protected:
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Query query;
+  Table const* table;
+};
+
+template <typename Query, typename OrderBy>
+using OrderByQuery =
+    QueryContinuation<Query, OrderByQueryImpl<Query, OrderBy>>;
+}
+
+#endif /* !MYSQL_ORM_ORDERBY_HPP_ */
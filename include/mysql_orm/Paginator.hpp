@@ -0,0 +1,145 @@
+#ifndef MYSQL_ORM_PAGINATOR_HPP_
+#define MYSQL_ORM_PAGINATOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Exception.hh>
+#include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/Where.hpp>
+#include <mysql_orm/WhereConditionDSL.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+
+namespace mysql_orm
+{
+/** Range over the pages of a table, using keyset pagination.
+ *
+ * Rows are ordered by `Attr`, which must be unique. The first page is
+ * selected with `ORDER BY attr LIMIT ?`, and the next ones with
+ * `WHERE attr > ? ORDER BY attr LIMIT ?`, the last key of the previous page
+ * being bound by reference. Each page thus costs the same regardless of its
+ * position, unlike with `OFFSET`, and the two statements are reused through
+ * the statement cache.
+ *
+ * The iterator refers to the current page, which is replaced when the
+ * iterator is incremented. Each call to `begin()` starts over from the first
+ * page.
+ */
+template <auto Attr, typename Table>
+class Paginator
+{
+public:
+  using model_type = meta::AttributeModelGetter_t<decltype(Attr)>;
+  using key_type = meta::AttributeGetter_t<decltype(Attr)>;
+  using page_type = std::vector<model_type>;
+
+  class iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = page_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = page_type const*;
+    using reference = page_type const&;
+
+    constexpr iterator() noexcept : paginator{nullptr}
+    {
+    }
+    constexpr explicit iterator(Paginator* p) noexcept : paginator{p}
+    {
+    }
+
+    reference operator*() const noexcept
+    {
+      return this->paginator->page;
+    }
+
+    pointer operator->() const noexcept
+    {
+      return &this->paginator->page;
+    }
+
+    iterator& operator++()
+    {
+      if (!this->paginator->next())
+        this->paginator = nullptr;
+      return *this;
+    }
+
+    void operator++(int)
+    {
+      ++*this;
+    }
+
+    constexpr bool operator==(iterator const& rhs) const noexcept
+    {
+      return this->paginator == rhs.paginator;
+    }
+
+    constexpr bool operator!=(iterator const& rhs) const noexcept
+    {
+      return !(*this == rhs);
+    }
+
+  private:
+    // nullptr for the end iterator.
+    Paginator* paginator;
+  };
+
+  Paginator(MYSQL& mysql,
+            Table const& t,
+            StatementCache* cache,
+            std::size_t psize)
+    : mysql_handle{&mysql},
+      table{&t},
+      stmt_cache{cache},
+      page_size{psize},
+      last_key{},
+      page{}
+  {
+    if (psize == 0)
+      throw Exception("Page size may not be 0");
+  }
+
+  iterator begin()
+  {
+    this->page = this->table->getAll(*this->mysql_handle, this->stmt_cache)(
+        OrderBy<Attr>{})(Limit<>{this->page_size})();
+    return this->page.empty() ? iterator{} : iterator{this};
+  }
+
+  constexpr iterator end() const noexcept
+  {
+    return iterator{};
+  }
+
+private:
+  bool next()
+  {
+    // A short page is the last one.
+    if (this->page.size() < this->page_size)
+      return false;
+    this->last_key = this->page.back().*Attr;
+    this->page = this->table->getAll(*this->mysql_handle, this->stmt_cache)(
+        Where{c<Attr>{} > ref{this->last_key}})(OrderBy<Attr>{})(
+        Limit<>{this->page_size})();
+    return !this->page.empty();
+  }
+
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Table const* table;
+  StatementCache* stmt_cache;
+  std::size_t page_size;
+  key_type last_key;
+  page_type page;
+};
+}
+
+#endif /* !MYSQL_ORM_PAGINATOR_HPP_ */
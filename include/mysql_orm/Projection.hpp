@@ -0,0 +1,428 @@
+#ifndef MYSQL_ORM_PROJECTION_HPP_
+#define MYSQL_ORM_PROJECTION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <CompileString/CompileString.hpp>
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Aggregate.hpp>
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/GroupBy.hpp>
+#include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
+#include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/RowStream.hpp>
+#include <mysql_orm/SQLText.hpp>
+#include <mysql_orm/Statement.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/Where.hpp>
+#include <mysql_orm/WhereConditionDSL.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+
+namespace mysql_orm
+{
+/** Projection of a column, for `Projection` queries.
+ *
+ * If `Target` is given, the value is stored in that attribute of the result.
+ * Otherwise, results are `std::tuple`s.
+ */
+template <auto Attr, auto Target = nullptr>
+struct Field
+{
+  template <std::size_t N>
+  using CompileString = compile_string::CompileString<N>;
+
+  static inline constexpr auto attribute{Attr};
+  static inline constexpr auto target{Target};
+  using value_type = meta::AttributeGetter_t<decltype(Attr)>;
+
+  template <typename Table>
+  static constexpr std::size_t varcharSize() noexcept
+  {
+    return std::remove_reference_t<decltype(
+        std::declval<Table const&>()
+            .template getColumn<Attr>())>::varchar_size;
+  }
+
+  template <std::size_t N, typename Table>
+  auto appendToQuery(CompileString<N> const& query, Table const& t) const
+  {
+    return query + '`' + t.template getColumn<Attr>().getName() + '`';
+  }
+};
+
+/** Projection of an aggregate, for `Projection` queries and `Having`
+ * conditions.
+ *
+ * `Attr` is `nullptr` for `COUNT(*)`. See `Field` for `Target`.
+ */
+template <AggregateFunction F, auto Attr, auto Target = nullptr>
+struct AggregateOf
+{
+  template <std::size_t N>
+  using CompileString = compile_string::CompileString<N>;
+
+  static inline constexpr auto attribute{Attr};
+  static inline constexpr auto target{Target};
+  using value_type = typename details::AggregateResult<F, Attr>::type;
+
+  template <typename Table>
+  static constexpr std::size_t varcharSize() noexcept
+  {
+    if constexpr (F == AggregateFunction::Min ||
+                  F == AggregateFunction::Max)
+      return Field<Attr>::template varcharSize<Table>();
+    else
+      return 0;
+  }
+
+  template <std::size_t N, typename Table>
+  auto appendToQuery(CompileString<N> const& query, Table const& t) const
+  {
+    if constexpr (F == AggregateFunction::Count)
+      return query + details::aggregateExpressionCS<F>(t);
+    else
+      return query + details::aggregateExpressionCS<F, Attr>(t);
+  }
+
+  static constexpr size_t getNbInputSlots() noexcept
+  {
+    return 0;
+  }
+
+  template <std::size_t NBINDS>
+  void bindInTo(InputBindArray<NBINDS>&, std::size_t) const noexcept
+  {
+  }
+
+  template <std::size_t NBINDS>
+  void rebindStdTmReferences(InputBindArray<NBINDS>&, std::size_t) const
+      noexcept
+  {
+  }
+
+#define MAKE_OPERATORS(op, type)                                              \
+  template <typename T>                                                       \
+  auto operator op(T const& rhs) const                                        \
+  {                                                                           \
+    return OperatorClosure<AggregateOf,                                       \
+                           OperandWrapper<T>,                                 \
+                           OperatorType::type>{                               \
+        *this, OperandWrapper<T>{rhs}};                                       \
+  }                                                                           \
+                                                                              \
+  template <typename T>                                                       \
+  auto operator op(ref<T> const& rhs) const                                   \
+  {                                                                           \
+    return OperatorClosure<AggregateOf, ref<T>, OperatorType::type>{*this,    \
+                                                                    rhs};     \
+  }
+
+  MAKE_OPERATORS(==, Equals)
+  MAKE_OPERATORS(!=, NotEquals)
+  MAKE_OPERATORS(>, GreaterThan)
+  MAKE_OPERATORS(>=, GreaterOrEquals)
+  MAKE_OPERATORS(<, LessThan)
+  MAKE_OPERATORS(<=, LessOrEquals)
+#undef MAKE_OPERATORS
+};
+
+template <auto Target = nullptr>
+using Count = AggregateOf<AggregateFunction::Count, nullptr, Target>;
+template <auto Attr, auto Target = nullptr>
+using Sum = AggregateOf<AggregateFunction::Sum, Attr, Target>;
+template <auto Attr, auto Target = nullptr>
+using Min = AggregateOf<AggregateFunction::Min, Attr, Target>;
+template <auto Attr, auto Target = nullptr>
+using Max = AggregateOf<AggregateFunction::Max, Attr, Target>;
+template <auto Attr, auto Target = nullptr>
+using Avg = AggregateOf<AggregateFunction::Avg, Attr, Target>;
+
+namespace details
+{
+template <typename Projection>
+inline constexpr bool has_target_v =
+    !std::is_same_v<std::remove_cv_t<decltype(Projection::target)>,
+                    std::nullptr_t>;
+
+/** Metafunction returning the type of the rows of a `Projection`.
+ *
+ * This is the class of the targets if all projections have one, and a
+ * `std::tuple` of the projected values if none has.
+ */
+template <typename Projection, typename... Projections>
+struct ProjectionResult
+{
+  static inline constexpr bool with_targets{has_target_v<Projection>};
+  static_assert(((has_target_v<Projections> == with_targets) && ...),
+                "Either all or no projections must have a target");
+
+  template <typename P, bool = with_targets>
+  struct TargetModel
+  {
+    using type = void;
+  };
+  template <typename P>
+  struct TargetModel<P, true>
+  {
+    using type = meta::AttributeModelGetter_t<
+        std::remove_cv_t<decltype(P::target)>>;
+  };
+
+  using type = std::conditional_t<
+      with_targets,
+      typename TargetModel<Projection>::type,
+      std::tuple<typename Projection::value_type,
+                 typename Projections::value_type...>>;
+
+  static_assert(
+      !with_targets ||
+          (std::is_same_v<typename TargetModel<Projections>::type, type> &&
+           ...),
+      "Targets do not refer to the same class");
+};
+
+/** Metafunction returning the model of the first projection with an
+ * attribute.
+ */
+template <typename... Projections>
+struct ProjectionModel
+{
+  static_assert(sizeof...(Projections) > 0,
+                "Projections must refer to at least one attribute");
+};
+
+template <auto Attr, auto Target, typename... Projections>
+struct ProjectionModel<Field<Attr, Target>, Projections...>
+{
+  using type = meta::AttributeModelGetter_t<decltype(Attr)>;
+};
+
+template <AggregateFunction F, auto Attr, auto Target, typename... Projections>
+struct ProjectionModel<AggregateOf<F, Attr, Target>, Projections...>
+{
+  using type = meta::AttributeModelGetter_t<decltype(Attr)>;
+};
+
+template <auto Target, typename... Projections>
+struct ProjectionModel<AggregateOf<AggregateFunction::Count, nullptr, Target>,
+                       Projections...>
+{
+  using type = typename ProjectionModel<Projections...>::type;
+};
+
+template <typename... Projections>
+using ProjectionModel_t = typename ProjectionModel<Projections...>::type;
+
+/** Returns the attribute of `row` the `I`th projection is stored into.
+ */
+template <std::size_t I, typename Projection, typename Result>
+auto& projectionTarget(Result& row) noexcept
+{
+  if constexpr (has_target_v<Projection>)
+  {
+    static_assert(
+        std::is_same_v<meta::AttributeGetter_t<
+                           std::remove_cv_t<decltype(Projection::target)>>,
+                       typename Projection::value_type>,
+        "Target does not have the type of the projection");
+    return row.*(Projection::target);
+  }
+  else
+    return std::get<I>(row);
+}
+
+template <typename Projection,
+          typename... Projections,
+          typename Query,
+          typename Table>
+auto appendProjections(Query const& query, Table const& t)
+{
+  auto const next = Projection{}.appendToQuery(query, t);
+  if constexpr (sizeof...(Projections) == 0)
+    return next;
+  else
+    return appendProjections<Projections...>(next + ", ", t);
+}
+}
+
+/** A query selecting columns and aggregates.
+ *
+ * Projections are `Field`s and aggregates (`Count`, `Sum`, `Min`, `Max` or
+ * `Avg`). Rows are `std::tuple`s of the projected values, or instances of the
+ * class of the projections' targets.
+ *
+ * `buildquery` returns a view of the SQL query.
+ * `build` returns a `Statement`, which can later be `execute()`d.
+ * `stream` returns a `RowStream`, which fetches rows one at a time.
+ *
+ * The `operator()` can be used to continue the query (Where, GroupBy, OrderBy,
+ * Limit).
+ */
+template <typename Table, typename... Projections>
+class Projection
+{
+public:
+  using table_type = Table;
+  using model_type =
+      typename details::ProjectionResult<Projections...>::type;
+  static inline constexpr auto query_type{QueryType::GetAll};
+
+  constexpr Projection(MYSQL& mysql,
+                       Table const& t,
+                       StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
+  {
+  }
+  constexpr Projection(Projection const& b) noexcept = default;
+  constexpr Projection(Projection&& b) noexcept = default;
+  ~Projection() noexcept = default;
+
+  constexpr Projection& operator=(Projection const& rhs) noexcept = default;
+  constexpr Projection& operator=(Projection&& rhs) noexcept = default;
+
+  template <typename Condition>
+  constexpr WhereQuery<Projection, Condition> operator()(
+      Where<Condition> where)
+  {
+    return WhereQuery<Projection, Condition>{
+        *this->mysql_handle, *this, *this->table, std::move(where.condition)};
+  }
+
+  template <auto Attr, auto... Attrs>
+  constexpr GroupByQuery<Projection, GroupBy<Attr, Attrs...>> operator()(
+      GroupBy<Attr, Attrs...> group)
+  {
+    return GroupByQuery<Projection, GroupBy<Attr, Attrs...>>{
+        *this->mysql_handle, *this, *this->table, std::move(group)};
+  }
+
+  template <auto Attr, typename Direction>
+  constexpr OrderByQuery<Projection, OrderBy<Attr, Direction>> operator()(
+      OrderBy<Attr, Direction> order)
+  {
+    return OrderByQuery<Projection, OrderBy<Attr, Direction>>{
+        *this->mysql_handle, *this, *this->table, std::move(order)};
+  }
+
+  template <typename Limit>
+  constexpr LimitQuery<Projection, Limit> operator()(Limit limit)
+  {
+    return LimitQuery<Projection, Limit>{
+        *this->mysql_handle, *this, *this->table, std::move(limit)};
+  }
+
+  auto operator()()
+  {
+    return this->build().execute();
+  }
+
+  RowStream<Projection, model_type> stream() const
+  {
+    return RowStream<Projection, model_type>{*this};
+  }
+
+  std::string_view buildquery() const
+  {
+    return details::SQLText<Projection>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
+  }
+
+  constexpr auto buildqueryCS() const noexcept
+  {
+    return details::appendProjections<Projections...>(
+               compile_string::CompileString{"SELECT "}, *this->table) +
+           " FROM `" + this->table->getName() + '`';
+  }
+
+  constexpr Statement<Projection, model_type> build() const
+  {
+    return Statement<Projection, model_type>{*this->mysql_handle, *this};
+  }
+
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
+  constexpr static size_t getNbInputSlots() noexcept
+  {
+    return 0;
+  }
+
+  constexpr static size_t getNbOutputSlots() noexcept
+  {
+    return sizeof...(Projections);
+  }
+
+  template <std::size_t NBINDS>
+  void bindOutTo(model_type& model, OutputBindArray<NBINDS>& binds) const
+  {
+    this->bindOutToImpl(
+        model, binds, std::index_sequence_for<Projections...>{});
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void bindInTo(InputBindArray<NBINDS>&) const noexcept
+  {
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void rebindStdTmReferences(InputBindArray<NBINDS>&) const noexcept
+  {
+  }
+
+  template <std::size_t NBINDS>
+  constexpr void finalizeBindings(MYSQL_STMT& stmt,
+                                  model_type const& bound,
+                                  model_type& model,
+                                  OutputBindArray<NBINDS>& binds)
+  {
+    this->finalizeBindingsImpl(
+        stmt, bound, model, binds, std::index_sequence_for<Projections...>{});
+  }
+
+private:
+  template <std::size_t NBINDS, std::size_t... Is>
+  void bindOutToImpl(model_type& model,
+                     OutputBindArray<NBINDS>& binds,
+                     std::index_sequence<Is...>) const
+  {
+    (binds.template bind<Projections::template varcharSize<Table>()>(
+         Is, details::projectionTarget<Is, Projections>(model)),
+     ...);
+  }
+
+  template <std::size_t NBINDS, std::size_t... Is>
+  void finalizeBindingsImpl(MYSQL_STMT& stmt,
+                            model_type const& bound,
+                            model_type& model,
+                            OutputBindArray<NBINDS>& binds,
+                            std::index_sequence<Is...>)
+  {
+    (binds.finalize(stmt,
+                    Is,
+                    details::projectionTarget<Is, Projections>(bound),
+                    details::projectionTarget<Is, Projections>(model)),
+     ...);
+  }
+
+  // May not be nullptr. Can't use std::reference_wrapper since MYSQL is
+  // incomplete.
+  MYSQL* mysql_handle;
+  Table const* table;
+  StatementCache* stmt_cache;
+};
+}
+
+#endif /* !MYSQL_ORM_PROJECTION_HPP_ */
@@ -0,0 +1,270 @@
+#ifndef MYSQL_ORM_QUERYAUDITOR_HPP_
+#define MYSQL_ORM_QUERYAUDITOR_HPP_
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/Exception.hh>
+
+namespace mysql_orm
+{
+/** Access to one table in a query plan.
+ */
+struct PlanTable
+{
+  std::string table_name;
+  // `ALL` for a full table scan.
+  std::string access_type;
+  // Empty if no index is used.
+  std::string key;
+  // Estimate of the rows read for each scan of the table.
+  unsigned long long rows{0};
+};
+
+/** The plan of a query, as reported by `EXPLAIN FORMAT=JSON`.
+ */
+struct QueryPlan
+{
+  std::string sql;
+  std::vector<PlanTable> tables;
+  bool using_filesort{false};
+  // Tables fully scanned with at least `full_scan_threshold` rows.
+  std::vector<std::string> full_scans;
+};
+
+enum class AuditMode
+{
+  // Reports issues with the callback.
+  Sampled,
+  // Reports issues with the callback, then throws a `QueryPlanException` on
+  // full table scans.
+  Strict
+};
+
+namespace details
+{
+/** Returns the value following `"name":` in `json`, starting at `pos`.
+ *
+ * The value is returned without its quotes if it is a string. `pos` is set
+ * past the value. Returns an empty view if the name is not found.
+ */
+inline std::string_view findJSONValue(std::string_view json,
+                                      std::string_view name,
+                                      std::size_t& pos)
+{
+  auto const quoted = '"' + std::string{name} + '"';
+  auto const key_pos = json.find(quoted, pos);
+  if (key_pos == std::string_view::npos)
+    return {};
+  auto begin = json.find_first_not_of(" \t\n:", key_pos + quoted.size());
+  if (begin == std::string_view::npos)
+    return {};
+  auto end = std::string_view::size_type{};
+  if (json[begin] == '"')
+  {
+    ++begin;
+    end = json.find('"', begin);
+  }
+  else
+    end = json.find_first_of(",}\n", begin);
+  if (end == std::string_view::npos)
+    end = json.size();
+  pos = end;
+  return json.substr(begin, end - begin);
+}
+
+/** Extracts the tables and sort operations of an `EXPLAIN FORMAT=JSON`.
+ *
+ * This is no JSON parser. It relies on MySQL printing `table_name` first in
+ * each table object.
+ */
+inline QueryPlan parseQueryPlan(std::string sql, std::string_view json)
+{
+  auto plan = QueryPlan{};
+  plan.sql = std::move(sql);
+  auto pos = std::size_t{0};
+  while (true)
+  {
+    auto const name = findJSONValue(json, "table_name", pos);
+    if (name.empty())
+      break;
+    auto const next = json.find("\"table_name\"", pos);
+    auto const object = json.substr(0, next);
+    auto table = PlanTable{};
+    table.table_name = std::string{name};
+    auto field_pos = pos;
+    table.access_type = findJSONValue(object, "access_type", field_pos);
+    field_pos = pos;
+    table.key = findJSONValue(object, "key", field_pos);
+    field_pos = pos;
+    auto const rows =
+        std::string{findJSONValue(object, "rows_examined_per_scan", field_pos)};
+    table.rows = std::strtoull(rows.c_str(), nullptr, 10);
+    plan.tables.push_back(std::move(table));
+  }
+  pos = 0;
+  plan.using_filesort = findJSONValue(json, "using_filesort", pos) == "true";
+  return plan;
+}
+
+/** Runs `EXPLAIN FORMAT=JSON` on `sql`, with the parameters `binds`.
+ *
+ * Returns the JSON document.
+ */
+inline std::string explain(MYSQL& mysql,
+                           std::string_view sql,
+                           MYSQL_BIND* binds,
+                           std::size_t nb_binds)
+{
+  auto const explain_sql = "EXPLAIN FORMAT=JSON " + std::string{sql};
+  auto stmt = std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)>{
+      mysql_stmt_init(&mysql), &mysql_stmt_close};
+  if (!stmt)
+    throw MySQLException("Failed to create statement: " +
+                         std::string{mysql_error(&mysql)});
+  if (mysql_stmt_prepare(stmt.get(), explain_sql.c_str(), explain_sql.size()))
+    throw MySQLException("Failed to prepare statement: " +
+                         std::string{mysql_stmt_error(stmt.get())});
+
+  auto length = 0ul;
+  auto result = MYSQL_BIND{};
+  result.buffer_type = MYSQL_TYPE_STRING;
+  result.length = &length;
+  if ((nb_binds > 0 && mysql_stmt_bind_param(stmt.get(), binds)) ||
+      mysql_stmt_bind_result(stmt.get(), &result))
+    throw MySQLException("Failed to bind statement: " +
+                         std::string{mysql_stmt_error(stmt.get())});
+  if (mysql_stmt_execute(stmt.get()))
+    throw MySQLException("Failed to execute statement: " +
+                         std::string{mysql_stmt_error(stmt.get())});
+
+  auto json = std::string{};
+  auto const errcode = mysql_stmt_fetch(stmt.get());
+  if (errcode == MYSQL_DATA_TRUNCATED)
+  {
+    json.resize(length);
+    result.buffer = json.data();
+    result.buffer_length = length;
+    if (mysql_stmt_fetch_column(stmt.get(), &result, 0, 0))
+      throw MySQLException("Failed to fetch column: " +
+                           std::string{mysql_stmt_error(stmt.get())});
+  }
+  else if (errcode && errcode != MYSQL_NO_DATA)
+    throw MySQLException(mysql_stmt_error(stmt.get()));
+  mysql_stmt_free_result(stmt.get());
+  return json;
+}
+}
+
+/** Used to indicate that a query plan was rejected by a strict auditor.
+ */
+class QueryPlanException : public Exception
+{
+public:
+  explicit QueryPlanException(QueryPlan p) noexcept
+    : Exception("Full table scan in query: " + p.sql), plan{std::move(p)}
+  {
+  }
+
+  QueryPlan plan;
+};
+
+/** Audits the plans of queries with `EXPLAIN`.
+ *
+ * The first time a statement is prepared for an SQL query, the auditor runs
+ * `EXPLAIN FORMAT=JSON` on it, with the parameters of its first execution.
+ * Plans with full table scans of at least `full_scan_threshold` rows, or with
+ * a filesort, are given to the callback.
+ *
+ * In sampled mode, only one query out of `sample_one_in` is audited. Queries
+ * are chosen by a hash of their SQL text, so that the choice is stable.
+ *
+ * The auditor is set on a `StatementCache` (see `Database::setAuditor`), and
+ * may be shared by several caches.
+ */
+class QueryAuditor
+{
+public:
+  using Callback = std::function<void(QueryPlan const&)>;
+
+  explicit QueryAuditor(Callback cb,
+                        AuditMode m = AuditMode::Sampled,
+                        unsigned long long threshold = 1000,
+                        std::size_t sample = 1)
+    : callback{std::move(cb)},
+      mode{m},
+      full_scan_threshold{threshold},
+      sample_one_in{sample == 0 ? 1 : sample},
+      mutex{},
+      audited{}
+  {
+  }
+
+  QueryAuditor(QueryAuditor const& b) = delete;
+  QueryAuditor(QueryAuditor&& b) = delete;
+  ~QueryAuditor() noexcept = default;
+
+  QueryAuditor& operator=(QueryAuditor const& rhs) = delete;
+  QueryAuditor& operator=(QueryAuditor&& rhs) = delete;
+
+  /** Returns true if `sql` has not been seen yet and is sampled.
+   *
+   * Each SQL text is only considered once.
+   */
+  bool shouldAudit(std::string_view sql)
+  {
+    auto lock = std::lock_guard{this->mutex};
+    if (!this->audited.emplace(sql).second)
+      return false;
+    return std::hash<std::string_view>{}(sql) % this->sample_one_in == 0;
+  }
+
+  /** Explains `sql` with the given parameters, and reports its issues.
+   */
+  void audit(MYSQL& mysql,
+             std::string_view sql,
+             MYSQL_BIND* binds,
+             std::size_t nb_binds)
+  {
+    auto plan = details::parseQueryPlan(
+        std::string{sql}, details::explain(mysql, sql, binds, nb_binds));
+    for (auto const& table : plan.tables)
+      if (table.access_type == "ALL" &&
+          table.rows >= this->full_scan_threshold)
+        plan.full_scans.push_back(table.table_name);
+    if (plan.full_scans.empty() && !plan.using_filesort)
+      return;
+    if (this->callback)
+      this->callback(plan);
+    if (this->mode == AuditMode::Strict && !plan.full_scans.empty())
+      throw QueryPlanException(std::move(plan));
+  }
+
+  /** Forgets audited queries, so that they are audited again.
+   */
+  void reset()
+  {
+    auto lock = std::lock_guard{this->mutex};
+    this->audited.clear();
+  }
+
+private:
+  Callback callback;
+  AuditMode mode;
+  unsigned long long full_scan_threshold;
+  std::size_t sample_one_in;
+  std::mutex mutex;
+  std::set<std::string, std::less<>> audited;
+};
+}
+
+#endif /* !MYSQL_ORM_QUERYAUDITOR_HPP_ */
@@ -2,9 +2,15 @@
 #define MYSQL_ORM_QUERYCONTINUATION_HPP_
 
 #include <functional>
+#include <string_view>
 
 #include <mysql/mysql.h>
 
+#include <mysql_orm/AsyncCallback.hpp>
+#include <mysql_orm/ColumnarResult.hpp>
+#include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/RowStream.hpp>
+#include <mysql_orm/SQLText.hpp>
 #include <mysql_orm/Statement.hpp>
 
 namespace mysql_orm
@@ -22,7 +28,9 @@ namespace mysql_orm
  * alias may be created on `QueryContinuation<Query, Table, WhereImpl<...>>`.
  *
  * This class defines:
- *   - `buildquery`: Returns the SQL query as a std::string.
+ *   - `buildquery`: Returns a view of the SQL query (see `details::SQLText`).
+ *   - `getStatementCache`: Returns the cache of the root query, if any.
+ *   - `getTable`: Returns the table of the query.
  *   - `getNbInputSlots`: Returns the number of input slots the class (and
  *     parents) needs.
  *   - `getNbOutputSlots`: Returns the number of output slots the class (and
@@ -31,8 +39,13 @@ namespace mysql_orm
  *   - `bindOutTo`: Binds output slots of the class (and parents).
  *   - `rebindStdTmReferences`: Re-convert `std::tm`s to `MYSQL_TIME` for
  *     references that might have been updated in DSLs.
- *   - `finalizeBindings`: Performs last-minute operations on fields before
- *     copying.
+ *   - `finalizeBindings`: Decodes a fetched row from the bound model into
+ *     another one.
+ *   - `stream`: Returns a `RowStream` over the results (`GetAll` only).
+ *   - `columns`: Returns the results as a `ColumnarResult` (`GetAll` on a
+ *     single table only).
+ *   - `async`: Executes the query on an `EventLoop` (see `AsyncQuery`, whose
+ *     header must be included).
  *
  * The methods `getNbInputSlots` and `bindInTo` are handled particularly.
  * If one exists in `Continuation`, `QueryContinuation` will use this one. It
@@ -77,9 +90,19 @@ public:
     return this->build().execute();
   }
 
-  constexpr auto buildquery() const noexcept
+  std::string_view buildquery() const
   {
-    return this->buildqueryCS();
+    return details::SQLText<QueryContinuation>::get(*this);
+  }
+
+  constexpr table_type const& getTable() const noexcept
+  {
+    return *this->table;
+  }
+
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->query.getStatementCache();
   }
 
   static constexpr size_t getNbInputSlots() noexcept
@@ -111,9 +134,12 @@ public:
   }
 
   template <std::size_t NBINDS>
-  void finalizeBindings(model_type& model, OutputBindArray<NBINDS>& binds)
+  void finalizeBindings(MYSQL_STMT& stmt,
+                        model_type const& bound,
+                        model_type& model,
+                        OutputBindArray<NBINDS>& binds)
   {
-    this->query.finalizeBindings(model, binds);
+    this->query.finalizeBindings(stmt, bound, model, binds);
   }
 
   constexpr Statement<QueryContinuation, model_type> build() const noexcept
@@ -121,6 +147,31 @@ public:
     return Statement<QueryContinuation, model_type>{*this->mysql_handle, *this};
   }
 
+  RowStream<QueryContinuation, model_type> stream() const
+  {
+    static_assert(query_type == QueryType::GetAll,
+                  "Only GetAll queries can be streamed");
+    return RowStream<QueryContinuation, model_type>{*this};
+  }
+
+  auto columns() const
+  {
+    static_assert(query_type == QueryType::GetAll,
+                  "Only GetAll queries can return columns");
+    return this->build()
+        .template executeColumns<
+            details::ColumnarResultOf_t<QueryContinuation>>();
+  }
+
+  void async(EventLoop& loop,
+             AsyncCallback<query_type, model_type> callback) const
+  {
+    static_assert(query_type != QueryType::Aggregate,
+                  "Aggregate queries can not be executed asynchronously");
+    AsyncQuery<QueryContinuation, model_type>::start(
+        *this, loop, std::move(callback));
+  }
+
 private:
   template <typename Q>
   static constexpr auto getNbInputSlotsImpl(int) noexcept
@@ -169,6 +220,15 @@ private:
 
 template <typename Query, typename Continuation>
 QueryContinuation(Query, Continuation)->QueryContinuation<Query, Continuation>;
+
+namespace details
+{
+template <typename Query, typename Continuation>
+struct ColumnarResultOf<QueryContinuation<Query, Continuation>>
+  : ColumnarResultOf<Query>
+{
+};
+}
 }
 
 #endif /* !MYSQL_ORM_QUERYCONTINUATION_HPP_ */
@@ -9,7 +9,8 @@ enum class QueryType
   Insert,
   Update,
   Delete,
-  GetAll
+  GetAll,
+  Aggregate
 };
 }
 
@@ -0,0 +1,115 @@
+#ifndef MYSQL_ORM_RELATION_HPP_
+#define MYSQL_ORM_RELATION_HPP_
+
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mysql/mysql.h>
+
+#include <mysql_orm/GetByIds.hpp>
+#include <mysql_orm/StatementCache.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/IsOptional.hpp>
+#include <mysql_orm/meta/LiftOptional.hpp>
+
+namespace mysql_orm
+{
+/** One-to-many relation between two models.
+ *
+ * `Key` is the attribute of the parent model that `ForeignKey`, an attribute
+ * of the child model, refers to. `Children` is the container attribute of the
+ * parent model the children are stored into (such as a `std::vector`). It
+ * must not be a column of the parent table. The foreign key may be an
+ * optional, in which case children whose foreign key is null are not loaded.
+ *
+ * For instance, `HasMany<&Order::id, &Line::order_id, &Order::lines>`.
+ */
+template <auto Key, auto ForeignKey, auto Children>
+struct HasMany
+{
+  using parent_type = meta::AttributeModelGetter_t<decltype(Key)>;
+  using child_type = meta::AttributeModelGetter_t<decltype(ForeignKey)>;
+  using key_type = meta::AttributeGetter_t<decltype(Key)>;
+  using foreign_key_type = meta::AttributeGetter_t<decltype(ForeignKey)>;
+
+  static_assert(std::is_same_v<meta::LiftOptional_t<key_type>,
+                               meta::LiftOptional_t<foreign_key_type>>,
+                "Key and foreign key do not have the same type");
+
+  static_assert(
+      std::is_same_v<meta::AttributeModelGetter_t<decltype(Children)>,
+                     parent_type>,
+      "Children attribute does not refer to the parent model");
+  static_assert(
+      std::is_same_v<
+          typename meta::AttributeGetter_t<decltype(Children)>::value_type,
+          child_type>,
+      "Children attribute does not hold child models");
+
+  static inline constexpr auto key = Key;
+  static inline constexpr auto foreign_key = ForeignKey;
+  static inline constexpr auto children = Children;
+};
+
+namespace details
+{
+/** Selects the children of the parents in `[first, last)` according to
+ * `Relation`, and appends them to their parents.
+ *
+ * Children are selected with `IN` lists of up to 128 parent keys (see
+ * `getByIds`), so that loading the children takes one query per 128 distinct
+ * keys, instead of one query per parent.
+ */
+template <typename Relation, typename ChildTable, typename Iterator>
+void loadRelation(MYSQL& mysql,
+                  ChildTable const& child_table,
+                  StatementCache* cache,
+                  Iterator first,
+                  Iterator last)
+{
+  using Parent_t = typename Relation::parent_type;
+  using Key_t = typename Relation::key_type;
+
+  auto parents_by_key = std::map<Key_t, std::vector<Parent_t*>>{};
+  for (; first != last; ++first)
+    parents_by_key[(*first).*Relation::key].push_back(&*first);
+  if (parents_by_key.empty())
+    return;
+
+  auto keys = std::vector<Key_t>{};
+  keys.reserve(parents_by_key.size());
+  for (auto const& [key, parents] : parents_by_key)
+    keys.push_back(key);
+
+  getByIds<Relation::foreign_key>(
+      mysql,
+      child_table,
+      cache,
+      keys.begin(),
+      keys.end(),
+      [&](auto&& child) {
+        auto const& foreign_key = child.*Relation::foreign_key;
+        auto it = parents_by_key.end();
+        if constexpr (meta::IsOptional_v<typename Relation::foreign_key_type>)
+        {
+          if (foreign_key)
+            it = parents_by_key.find(*foreign_key);
+        }
+        else
+          it = parents_by_key.find(foreign_key);
+        if (it == parents_by_key.end())
+          return;
+        // Parents sharing a key get copies, and the last one the child.
+        auto const& parents = it->second;
+        for (auto i = std::size_t{1}; i < parents.size(); ++i)
+          (parents[i - 1]->*Relation::children).push_back(child);
+        (parents.back()->*Relation::children)
+            .push_back(std::forward<decltype(child)>(child));
+      });
+}
+}
+}
+
+#endif /* !MYSQL_ORM_RELATION_HPP_ */
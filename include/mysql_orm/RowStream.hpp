@@ -0,0 +1,114 @@
+#ifndef MYSQL_ORM_ROWSTREAM_HPP_
+#define MYSQL_ORM_ROWSTREAM_HPP_
+
+#include <cstddef>
+#include <iterator>
+
+#include <mysql_orm/Statement.hpp>
+
+namespace mysql_orm
+{
+/** Range over the rows of a `GetAll` query.
+ *
+ * Rows are fetched one at a time from the server and decoded into a single
+ * model, which the iterator refers to. Memory usage does not depend on the
+ * number of rows. A row must be copied if it is needed after the iterator has
+ * been incremented.
+ *
+ * Each call to `begin()` executes the query again. While rows remain to be
+ * fetched, no other query may be performed on the connection.
+ *
+ * The statement is built in place and refers to its own members, hence this
+ * class is neither copyable nor movable.
+ */
+template <typename Query, typename Model>
+class RowStream
+{
+public:
+  class iterator
+  {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Model;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Model const*;
+    using reference = Model const&;
+
+    constexpr iterator() noexcept : stream{nullptr}
+    {
+    }
+    constexpr explicit iterator(RowStream* s) noexcept : stream{s}
+    {
+    }
+
+    reference operator*() const noexcept
+    {
+      return this->stream->row;
+    }
+
+    pointer operator->() const noexcept
+    {
+      return &this->stream->row;
+    }
+
+    iterator& operator++()
+    {
+      if (!this->stream->next())
+        this->stream = nullptr;
+      return *this;
+    }
+
+    void operator++(int)
+    {
+      ++*this;
+    }
+
+    constexpr bool operator==(iterator const& rhs) const noexcept
+    {
+      return this->stream == rhs.stream;
+    }
+
+    constexpr bool operator!=(iterator const& rhs) const noexcept
+    {
+      return !(*this == rhs);
+    }
+
+  private:
+    // nullptr for the end iterator.
+    RowStream* stream;
+  };
+
+  explicit RowStream(Query const& query) : stmt{query.build()}, row{}
+  {
+  }
+
+  RowStream(RowStream const& b) = delete;
+  RowStream(RowStream&& b) = delete;
+  ~RowStream() noexcept = default;
+
+  RowStream& operator=(RowStream const& rhs) = delete;
+  RowStream& operator=(RowStream&& rhs) = delete;
+
+  iterator begin()
+  {
+    this->stmt.sql_execute();
+    return this->next() ? iterator{this} : iterator{};
+  }
+
+  constexpr iterator end() const noexcept
+  {
+    return iterator{};
+  }
+
+private:
+  bool next()
+  {
+    return this->stmt.fetch(this->row);
+  }
+
+  Statement<Query, Model> stmt;
+  Model row;
+};
+}
+
+#endif /* !MYSQL_ORM_ROWSTREAM_HPP_ */
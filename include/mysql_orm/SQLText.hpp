@@ -0,0 +1,74 @@
+#ifndef MYSQL_ORM_SQLTEXT_HPP_
+#define MYSQL_ORM_SQLTEXT_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace mysql_orm
+{
+namespace details
+{
+/** SQL text of the queries of type `Query`.
+ *
+ * The SQL of a query is fully determined by its type, except for the table
+ * and column names held by its table. It is thus rendered from `buildqueryCS`
+ * once per set of names, the first time it is needed, and kept until the end
+ * of the program. Queries then only return a view of it.
+ *
+ * Lookups take no lock: entries are pushed at the front of a list, and never
+ * modified or removed.
+ */
+template <typename Query>
+class SQLText
+{
+public:
+  using Table = typename Query::table_type;
+
+  static std::string_view get(Query const& query)
+  {
+    auto const& table = query.getTable();
+    if (auto const* entry = find(table, head.load(std::memory_order_acquire)))
+      return entry->sql;
+    return insert(query);
+  }
+
+private:
+  struct Entry
+  {
+    Table table;
+    std::string sql;
+    Entry const* next;
+  };
+
+  static Entry const* find(Table const& table, Entry const* entry) noexcept
+  {
+    for (; entry; entry = entry->next)
+      if (entry->table.hasSameNames(table))
+        return entry;
+    return nullptr;
+  }
+
+  static std::string_view insert(Query const& query)
+  {
+    auto lock = std::lock_guard{mutex};
+    auto const& table = query.getTable();
+    auto const* first = head.load(std::memory_order_relaxed);
+    // Another thread may have rendered it since the lookup.
+    if (auto const* entry = find(table, first))
+      return entry->sql;
+    auto const sql = query.buildqueryCS();
+    auto const* entry =
+        new Entry{table, std::string{sql.c_str(), sql.size()}, first};
+    head.store(entry, std::memory_order_release);
+    return entry->sql;
+  }
+
+  static inline std::atomic<Entry const*> head{nullptr};
+  static inline std::mutex mutex{};
+};
+}
+}
+
+#endif /* !MYSQL_ORM_SQLTEXT_HPP_ */
@@ -34,7 +34,7 @@ struct Set
  * The class continues an `Update` query.
  * Takes a list of assignments as parameter, which must be an `AssignmentsList`.
  *
- * `buildquery` returns the SQL query as a std::string.
+ * `buildquery` returns a view of the SQL query.
  * `build` returns a `Statement`, which can later be `execute()`d.
  *
  * The `operator()` can be used to continue the query (Where).
@@ -1,47 +1,99 @@
 #ifndef MYSQL_ORM_STATEMENT_HPP_
 #define MYSQL_ORM_STATEMENT_HPP_
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <typeinfo>
 #include <vector>
 
 #include <mysql/mysql.h>
 
 #include <mysql_orm/BindArray.hpp>
 #include <mysql_orm/Exception.hh>
+#include <mysql_orm/Metrics.hpp>
+#include <mysql_orm/QueryAuditor.hpp>
 #include <mysql_orm/QueryType.hpp>
+#include <mysql_orm/StatementCache.hpp>
 
 namespace mysql_orm
 {
+template <typename Query, typename Model>
+class RowStream;
+
+template <typename Query, typename Model>
+class AsyncQuery;
+
+namespace details
+{
+/** Returns the number of `MYSQL_TIME`s in the input binds of `Query`.
+ *
+ * Queries that do not define `getNbInputTimeSlots` have one per slot.
+ */
+template <typename Query>
+constexpr auto getNbInputTimeSlots(int) noexcept
+    -> decltype(Query::getNbInputTimeSlots(), std::size_t())
+{
+  return Query::getNbInputTimeSlots();
+}
 
+template <typename Query>
+constexpr std::size_t getNbInputTimeSlots(long) noexcept
+{
+  return Query::getNbInputSlots();
+}
+}
+
+/** A prepared statement.
+ *
+ * If the query has a `StatementCache`, the handle is taken from it when
+ * available and given back to it upon destruction. The handle is otherwise
+ * prepared here and closed upon destruction.
+ *
+ * Statements prepared for a cache with a `QueryAuditor` are audited before
+ * their first execution.
+ *
+ * Statements using a cache with a `MetricsRegistry` record the duration of
+ * their phases, and the rows and bytes they decode, under the hash of their SQL
+ * text.
+ *
+ * `GetAll` statements may be put in buffered mode (see `setBuffered`).
+ */
 template <typename Query, typename Model>
 class Statement
 {
 public:
   static inline constexpr auto query_type{Query::query_type};
-
-  using SQLQueryType = decltype(std::declval<Query>().buildquery());
+  // Whether the statement returns rows.
+  static inline constexpr bool has_output{query_type == QueryType::GetAll ||
+                                          query_type == QueryType::Aggregate};
 
   Statement(MYSQL& mysql, Query pquery)
     : mysql_handle{&mysql},
       orm_query{std::move(pquery)},
       sql_query{this->orm_query.buildquery()},
+      stmt_cache{this->orm_query.getStatementCache()},
+      buffered{false},
+      needs_audit{false},
+      metrics{nullptr},
       in_binds{},
       out_binds{},
+      bound_in{},
+      bound_out{},
       stmt{nullptr, &mysql_stmt_close}
   {
-    this->stmt.reset(mysql_stmt_init(this->mysql_handle));
+    if constexpr (metrics_enabled)
+      if (this->stmt_cache && this->stmt_cache->getMetrics())
+        this->metrics = &this->stmt_cache->getMetrics()->getShapeMetrics(
+            fnv1a(this->getSQL()), this->getSQL());
+    if (this->stmt_cache)
+      this->stmt.reset(this->stmt_cache->take(typeid(Query), this->sql_query));
     if (!this->stmt)
-      throw MySQLException("Failed to create statement: " +
-                           std::string{mysql_error(this->mysql_handle)});
-    if (mysql_stmt_prepare(
-            this->stmt.get(), this->sql_query.c_str(),
-            this->sql_query.size()))
-      throw MySQLException("Failed to prepare statement: " +
-                           std::string{mysql_error(this->mysql_handle)});
-    if constexpr (query_type == QueryType::GetAll)
+      this->prepare();
+    if constexpr (has_output)
       this->bindOutToQuery();
     if constexpr (query_type != QueryType::Insert)
       this->bindInToQuery();
@@ -49,7 +101,16 @@ public:
 
   Statement(Statement const& b) = delete;
   Statement(Statement&& b) noexcept = default;
-  ~Statement() noexcept = default;
+  ~Statement() noexcept
+  {
+    // Other users of the handle should not pay for max lengths. If it can't
+    // be reset, the handle is closed instead.
+    if (this->stmt && this->buffered && this->setUpdateMaxLength(false))
+      this->stmt_cache = nullptr;
+    if (this->stmt && this->stmt_cache)
+      this->stmt_cache->give(
+          typeid(Query), this->sql_query, this->stmt.release());
+  }
 
   Statement& operator=(Statement const& rhs) = delete;
   Statement& operator=(Statement&& rhs) noexcept = default;
@@ -70,28 +131,71 @@ public:
     this->orm_query.bindInsert(this->temp, this->in_binds);
   }
 
+  /** Binds the models of a range in place (see `InsertBatch`).
+   */
+  template <typename Iterator>
+  void bindInsertRange(Iterator first)
+  {
+    this->orm_query.bindInsertRange(first, this->in_binds);
+  }
+
   void bindOutToQuery()
   {
     this->orm_query.bindOutTo(this->temp, this->out_binds);
   }
 
+  /** Enables or disables buffered mode.
+   *
+   * In buffered mode, the whole result is stored client-side upon execution.
+   * Output buffers for text columns are then sized once from the largest
+   * value of each column, so that no value is truncated and no byte is
+   * wasted. The raw result is held in memory until all rows are fetched.
+   */
+  Statement& setBuffered(bool b = true)
+  {
+    static_assert(query_type == QueryType::GetAll,
+                  "Only GetAll statements can be buffered");
+    if (b == this->buffered)
+      return *this;
+    if (this->setUpdateMaxLength(b))
+      throw MySQLException("Failed to set statement attribute: " +
+                           std::string{mysql_stmt_error(this->stmt.get())});
+    if (!b)
+    {
+      this->out_binds.resetBufferSizes();
+      this->bindOutToQuery();
+    }
+    this->buffered = b;
+    return *this;
+  }
+
+  bool isBuffered() const noexcept
+  {
+    return this->buffered;
+  }
+
   auto execute()
   {
     if constexpr (query_type == QueryType::GetAll)
     {
       auto ret = std::vector<Model>{};
       this->sql_execute();
-      auto errcode = 0;
-      while (!(errcode = mysql_stmt_fetch(this->stmt.get())))
-      {
-        auto copy = this->temp;
-        this->orm_query.finalizeBindings(copy, this->out_binds);
-        ret.emplace_back(std::move(copy));
-      }
-      if (errcode != MYSQL_NO_DATA)
-        throw MySQLException(mysql_stmt_error(this->stmt.get()));
+      // Rows are decoded in place. The last slot is the one that got no row.
+      while (this->fetch(ret.emplace_back()))
+        ;
+      ret.pop_back();
       return ret;
     }
+    else if constexpr (query_type == QueryType::Aggregate)
+    {
+      auto row = Model{};
+      this->sql_execute();
+      if (!this->fetch(row))
+        throw MySQLException("Aggregate query returned no row");
+      // Reads the end of the result, so the connection is usable by others.
+      mysql_stmt_free_result(this->stmt.get());
+      return std::move(row.value);
+    }
     else
     {
       this->sql_execute();
@@ -100,10 +204,80 @@ public:
     }
   }
 
+  /** Executes the query, and returns the rows as a `ColumnarResult`.
+   *
+   * Rows are decoded straight from the output binds into the columns. In
+   * buffered mode, the columns are allocated once for all rows.
+   */
+  template <typename Columns>
+  Columns executeColumns()
+  {
+    static_assert(query_type == QueryType::GetAll,
+                  "Only GetAll statements return columns");
+    auto ret = Columns{};
+    this->sql_execute();
+    if (this->buffered)
+      ret.reserve(mysql_stmt_num_rows(this->stmt.get()));
+    while (this->fetchColumns(ret))
+      ;
+    return ret;
+  }
+
 private:
+  friend class RowStream<Query, Model>;
+  friend class AsyncQuery<Query, Model>;
+
+  void prepare()
+  {
+    auto timer = details::PhaseTimer{this->metrics, Phase::Prepare};
+    this->stmt.reset(mysql_stmt_init(this->mysql_handle));
+    if (!this->stmt)
+      throw MySQLException("Failed to create statement: " +
+                           std::string{mysql_error(this->mysql_handle)});
+    if (mysql_stmt_prepare(
+            this->stmt.get(), this->sql_query.data(), this->sql_query.size()))
+      throw MySQLException("Failed to prepare statement: " +
+                           std::string{mysql_error(this->mysql_handle)});
+    if constexpr (query_type != QueryType::Insert)
+    {
+      auto* auditor =
+          this->stmt_cache ? this->stmt_cache->getAuditor() : nullptr;
+      this->needs_audit = auditor && auditor->shouldAudit(this->getSQL());
+    }
+  }
+
+  /** Sets whether the handle computes the maximal length of each column
+   * when storing the result. Returns non-zero on error.
+   */
+  my_bool setUpdateMaxLength(bool b) noexcept
+  {
+    auto update_max_length = my_bool{b};
+    return mysql_stmt_attr_set(
+        this->stmt.get(), STMT_ATTR_UPDATE_MAX_LENGTH, &update_max_length);
+  }
+
+  std::string_view getSQL() const noexcept
+  {
+    return this->sql_query;
+  }
+
+  /** Explains the statement with its bound parameters, if it was not yet.
+   */
+  void auditOnce()
+  {
+    if (!this->needs_audit)
+      return;
+    this->needs_audit = false;
+    this->stmt_cache->getAuditor()->audit(
+        *this->mysql_handle,
+        this->getSQL(),
+        const_cast<MYSQL_BIND*>(this->in_binds.data()),
+        Query::getNbInputSlots());
+  }
+
   constexpr static size_t getNbOutputSlots() noexcept
   {
-    if constexpr (query_type == QueryType::GetAll)
+    if constexpr (has_output)
       return Query::getNbOutputSlots();
     else
       return 0;
@@ -111,18 +285,159 @@ private:
 
   void sql_execute()
   {
+    this->bindAll();
+    this->auditOnce();
+    auto timer = details::PhaseTimer{this->metrics, Phase::Execute};
+    if (mysql_stmt_execute(this->stmt.get()))
+      this->executeFailed();
+    if constexpr (query_type == QueryType::GetAll)
+      if (this->buffered)
+        this->storeResult();
+  }
+
+  void bindAll()
+  {
+    auto timer = details::PhaseTimer{this->metrics, Phase::Bind};
     this->rebindStdTmReferences();
+    this->bindResult();
+    this->bindParam();
+  }
+
+  /** Gives the output binds to the handle, unless it already has them.
+   */
+  void bindResult()
+  {
+    if (this->out_binds.empty() || this->out_binds.version() == this->bound_out)
+      return;
     auto* mysql_out_binds = const_cast<MYSQL_BIND*>(this->out_binds.data());
+    if (mysql_stmt_bind_result(this->stmt.get(), mysql_out_binds))
+      this->bindFailed();
+    this->bound_out = this->out_binds.version();
+  }
+
+  /** Gives the input binds to the handle, unless it already has them.
+   *
+   * Values are read from the buffers upon execution, so only changes of
+   * buffers, lengths or types need binding again.
+   */
+  void bindParam()
+  {
+    if (this->in_binds.empty() || this->in_binds.version() == this->bound_in)
+      return;
     auto* mysql_in_binds = const_cast<MYSQL_BIND*>(this->in_binds.data());
-    if ((!this->out_binds.empty() &&
-         mysql_stmt_bind_result(this->stmt.get(), mysql_out_binds)) ||
-        (!this->in_binds.empty() &&
-         mysql_stmt_bind_param(this->stmt.get(), mysql_in_binds)))
-      throw MySQLException("Failed to bind statement: " +
+    if (mysql_stmt_bind_param(this->stmt.get(), mysql_in_binds))
+      this->bindFailed();
+    this->bound_in = this->in_binds.version();
+  }
+
+  [[noreturn]] void bindFailed()
+  {
+    throw MySQLException("Failed to bind statement: " +
+                         std::string{mysql_stmt_error(this->stmt.get())});
+  }
+
+  [[noreturn]] void executeFailed()
+  {
+    // The handle may have been invalidated (e.g.: by a reconnection). Do not
+    // give it back to the cache.
+    this->stmt_cache = nullptr;
+    throw MySQLException("Failed to execute statement: " +
+                         std::string{mysql_stmt_error(this->stmt.get())});
+  }
+
+  /** Stores the result client-side and sizes the output buffers from it.
+   */
+  void storeResult()
+  {
+    if (mysql_stmt_store_result(this->stmt.get()))
+      throw MySQLException("Failed to store result: " +
                            std::string{mysql_stmt_error(this->stmt.get())});
-    if (mysql_stmt_execute(this->stmt.get()))
-      throw MySQLException("Failed to execute statement: " +
+    auto metadata = std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)>{
+        mysql_stmt_result_metadata(this->stmt.get()), &mysql_free_result};
+    if (!metadata)
+      throw MySQLException("Failed to get result metadata: " +
                            std::string{mysql_stmt_error(this->stmt.get())});
+    for (auto i = 0u; i < getNbOutputSlots(); ++i)
+    {
+      auto const* field = mysql_fetch_field_direct(metadata.get(), i);
+      // A buffer size of 0 means the default size.
+      this->out_binds.setBufferSize(i, std::max(field->max_length, 1ul));
+    }
+    this->bindOutToQuery();
+    this->bindResult();
+  }
+
+  /** Fetches the next row of the result into `model`.
+   *
+   * The row is fetched in `temp`, whose attributes are bound, and then decoded
+   * into `model`. Only the actual data is copied. Truncated values are fetched
+   * again in full while decoding.
+   *
+   * Returns false if there are no more rows.
+   */
+  bool fetch(Model& model)
+  {
+    return this->decode(this->fetchRow(), model);
+  }
+
+  /** Fetches the next row of the result at the end of `columns`.
+   *
+   * Returns false if there are no more rows.
+   */
+  template <typename Columns>
+  bool fetchColumns(Columns& columns)
+  {
+    auto const errcode = this->fetchRow();
+    if (!this->checkRow(errcode))
+      return false;
+    auto timer = details::PhaseTimer{this->metrics, Phase::Decode};
+    columns.append(*this->stmt, this->temp, this->out_binds);
+    this->recordRow();
+    return true;
+  }
+
+  int fetchRow()
+  {
+    auto timer = details::PhaseTimer{this->metrics, Phase::Fetch};
+    return mysql_stmt_fetch(this->stmt.get());
+  }
+
+  /** Decodes the row fetched with result `errcode` into `model`.
+   */
+  bool decode(int errcode, Model& model)
+  {
+    if (!this->checkRow(errcode))
+      return false;
+    auto timer = details::PhaseTimer{this->metrics, Phase::Decode};
+    this->orm_query.finalizeBindings(
+        *this->stmt, this->temp, model, this->out_binds);
+    this->recordRow();
+    return true;
+  }
+
+  /** Returns false if `errcode` is the end of the result, and throws on
+   * errors.
+   */
+  bool checkRow(int errcode)
+  {
+    if (errcode == MYSQL_NO_DATA)
+      return false;
+    if (errcode && errcode != MYSQL_DATA_TRUNCATED)
+      throw MySQLException(mysql_stmt_error(this->stmt.get()));
+    return true;
+  }
+
+  /** Records the decoded row in the metrics, if any.
+   */
+  void recordRow() noexcept
+  {
+    if constexpr (metrics_enabled)
+      if (this->metrics)
+      {
+        this->metrics->rows.fetch_add(1, std::memory_order_relaxed);
+        this->metrics->bytes.fetch_add(this->out_binds.rowLength(),
+                                       std::memory_order_relaxed);
+      }
   }
 
   void rebindStdTmReferences()
@@ -133,9 +448,20 @@ private:
   MYSQL* mysql_handle;
   Model temp;
   Query orm_query;
-  SQLQueryType sql_query;
-  InputBindArray<Query::getNbInputSlots()> in_binds;
+  // Static storage (see `details::SQLText`).
+  std::string_view sql_query;
+  StatementCache* stmt_cache;
+  bool buffered;
+  bool needs_audit;
+  // Metrics of the shape of the statement for this thread, if recorded.
+  ShapeMetrics* metrics;
+  InputBindArray<Query::getNbInputSlots(),
+                 details::getNbInputTimeSlots<Query>(0)>
+      in_binds;
   OutputBindArray<Query::getNbOutputSlots()> out_binds;
+  // Versions of the binds the handle has.
+  details::BindVersion bound_in;
+  details::BindVersion bound_out;
   std::unique_ptr<MYSQL_STMT, decltype(&mysql_stmt_close)> stmt;
 };
 }
@@ -0,0 +1,213 @@
+#ifndef MYSQL_ORM_STATEMENTCACHE_HPP_
+#define MYSQL_ORM_STATEMENTCACHE_HPP_
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <typeindex>
+
+#include <mysql/mysql.h>
+
+namespace mysql_orm
+{
+class MetricsRegistry;
+class QueryAuditor;
+
+/** LRU cache of prepared statements.
+ *
+ * Handles are keyed by the type of the query that built them and by their SQL
+ * text. A `Statement` takes its handle out of the cache when it is built and
+ * gives it back when it is destroyed, so two live statements never share the
+ * same handle.
+ *
+ * At most `capacity()` handles are kept. When a handle is given back to a full
+ * cache, the least recently used one is closed. This allows staying under the
+ * server's `max_prepared_stmt_count`.
+ *
+ * Statements prepared for the cache are audited by its `QueryAuditor`, if any.
+ * Statements using the cache record their metrics into its `MetricsRegistry`,
+ * if any.
+ */
+class StatementCache
+{
+public:
+  static inline constexpr std::size_t default_capacity{64};
+
+  explicit StatementCache(std::size_t cap = default_capacity) noexcept
+    : max_size{cap}, index{}, lru{}, auditor{nullptr}, metrics{nullptr}
+  {
+  }
+
+  StatementCache(StatementCache const& b) = delete;
+  StatementCache(StatementCache&& b) = delete;
+  ~StatementCache() noexcept
+  {
+    this->clear();
+  }
+
+  StatementCache& operator=(StatementCache const& rhs) = delete;
+  StatementCache& operator=(StatementCache&& rhs) = delete;
+
+  /** Takes the handle matching the key out of the cache.
+   *
+   * Returns `nullptr` if there is none. The caller owns the handle until it
+   * gives it back.
+   */
+  MYSQL_STMT* take(std::type_index type, std::string_view sql) noexcept
+  {
+    auto it = this->index.find(KeyView{type, sql});
+    if (it == this->index.end())
+      return nullptr;
+    auto* stmt = it->second.stmt;
+    this->lru.erase(it->second.lru_pos);
+    this->index.erase(it);
+    return stmt;
+  }
+
+  /** Gives a handle back to the cache.
+   *
+   * The handle is closed instead if the cache already holds one for the same
+   * key. The least recently used handles are closed if the cache is full.
+   */
+  void give(std::type_index type,
+            std::string_view sql,
+            MYSQL_STMT* stmt) noexcept
+  {
+    if (this->max_size == 0 ||
+        this->index.find(KeyView{type, sql}) != this->index.end())
+    {
+      mysql_stmt_close(stmt);
+      return;
+    }
+    // Flushes any unread row, so the connection is usable by others.
+    mysql_stmt_free_result(stmt);
+    try
+    {
+      auto [it, inserted] =
+          this->index.emplace(Key{type, std::string{sql}}, Entry{stmt, {}});
+      (void)(inserted);
+      this->lru.push_front(&it->first);
+      it->second.lru_pos = this->lru.begin();
+    }
+    catch (...)
+    {
+      mysql_stmt_close(stmt);
+      return;
+    }
+    this->shrinkTo(this->max_size);
+  }
+
+  /** Closes all cached handles.
+   */
+  void clear() noexcept
+  {
+    for (auto& [key, entry] : this->index)
+      mysql_stmt_close(entry.stmt);
+    this->lru.clear();
+    this->index.clear();
+  }
+
+  std::size_t size() const noexcept
+  {
+    return this->index.size();
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return this->max_size;
+  }
+
+  /** Changes the capacity, closing handles if needed.
+   */
+  void setCapacity(std::size_t cap) noexcept
+  {
+    this->max_size = cap;
+    this->shrinkTo(cap);
+  }
+
+  /** Sets the auditor of the statements prepared for the cache.
+   *
+   * The auditor must outlive the cache, or be unset first. `nullptr` disables
+   * auditing.
+   */
+  void setAuditor(QueryAuditor* a) noexcept
+  {
+    this->auditor = a;
+  }
+
+  QueryAuditor* getAuditor() const noexcept
+  {
+    return this->auditor;
+  }
+
+  /** Sets the registry recording the metrics of the statements using the
+   * cache.
+   *
+   * The registry must outlive the statements, or be unset first while none is
+   * alive. `nullptr` disables metrics.
+   */
+  void setMetrics(MetricsRegistry* m) noexcept
+  {
+    this->metrics = m;
+  }
+
+  MetricsRegistry* getMetrics() const noexcept
+  {
+    return this->metrics;
+  }
+
+private:
+  struct Key
+  {
+    std::type_index type;
+    std::string sql;
+  };
+
+  struct KeyView
+  {
+    std::type_index type;
+    std::string_view sql;
+  };
+
+  struct KeyLess
+  {
+    using is_transparent = void;
+
+    template <typename A, typename B>
+    bool operator()(A const& a, B const& b) const noexcept
+    {
+      if (a.type != b.type)
+        return a.type < b.type;
+      return std::string_view{a.sql} < std::string_view{b.sql};
+    }
+  };
+
+  struct Entry
+  {
+    MYSQL_STMT* stmt;
+    // Most recently used first.
+    std::list<Key const*>::iterator lru_pos;
+  };
+
+  void shrinkTo(std::size_t cap) noexcept
+  {
+    while (this->index.size() > cap)
+    {
+      auto it = this->index.find(*this->lru.back());
+      mysql_stmt_close(it->second.stmt);
+      this->lru.pop_back();
+      this->index.erase(it);
+    }
+  }
+
+  std::size_t max_size;
+  std::map<Key, Entry, KeyLess> index;
+  std::list<Key const*> lru;
+  QueryAuditor* auditor;
+  MetricsRegistry* metrics;
+};
+}
+
+#endif /* !MYSQL_ORM_STATEMENTCACHE_HPP_ */
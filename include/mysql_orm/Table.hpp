@@ -1,6 +1,7 @@
 #ifndef MYSQL_ORM_TABLE_HPP
 #define MYSQL_ORM_TABLE_HPP
 
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -11,10 +12,15 @@
 
 #include <CompileString/CompileString.hpp>
 
+#include <mysql_orm/Aggregate.hpp>
+#include <mysql_orm/BulkLoad.hpp>
 #include <mysql_orm/Column.hpp>
 #include <mysql_orm/ColumnNamesJoiner.hpp>
 #include <mysql_orm/GetAll.hpp>
+#include <mysql_orm/Index.hpp>
 #include <mysql_orm/Insert.hpp>
+#include <mysql_orm/Projection.hpp>
+#include <mysql_orm/TableOptions.hpp>
 #include <mysql_orm/Utils.hpp>
 #include <mysql_orm/meta/ColumnAttributeGetter.hpp>
 #include <mysql_orm/meta/FindMapped.hpp>
@@ -38,25 +44,42 @@ auto const& getColumn_clang(std::tuple<Columns...> const& cols) noexcept
 
 /** A SQL Table.
  *
- * The table can be constructed with a name and columns (instanciations of the
- * `Column` template). Users should not manipulate this class directly.
+ * The table can be constructed with a name, indexes (a `std::tuple` of
+ * instanciations of the `Index` template), options (a `std::tuple` of table
+ * options, see TableOptions.hpp) and columns (instanciations of the `Column`
+ * template). Users should not manipulate this class directly.
  *
- * For the code to compile, all columns must refer to the same Model.
+ * For the code to compile, all columns must refer to the same Model, and
+ * indexes and options must only refer to attributes of the columns.
  *
- * The class defines one member type:
+ * The class defines two member types:
  *   - `model_type`: Alias to the Model the table refers to.
+ *   - `attributes_type`: `meta::ValuePack` of the attributes of the columns.
  */
-template <std::size_t NAME_SIZE, typename... Columns>
+template <std::size_t NAME_SIZE,
+          typename Indexes,
+          typename Options,
+          typename... Columns>
 class Table
 {
 public:
   using model_type = ColumnModel_t<Columns...>;
+  using attributes_type =
+      meta::ValuePack<meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>;
 
-  constexpr explicit Table(char const (&name)[NAME_SIZE], Columns&&... cols)
-    : table_name{name}, columns{std::forward_as_tuple(cols...)}
+  constexpr explicit Table(char const (&name)[NAME_SIZE],
+                           Indexes&& idxs,
+                           Options&& opts,
+                           Columns&&... cols)
+    : table_name{name},
+      columns{std::forward_as_tuple(cols...)},
+      indexes{std::move(idxs)},
+      options{std::move(opts)}
   {
     static_assert(ColumnsMatch_v<Columns...>,
                   "Columns do not refer to the same model type");
+    this->checkIndexes(static_cast<Indexes const*>(nullptr));
+    details::checkTableOptions<Table>(static_cast<Options const*>(nullptr));
   }
   constexpr Table(Table const& b) = default;
   constexpr Table(Table&& b) = default;
@@ -81,7 +104,43 @@ public:
                },
                CompileString<0>{""},
                this->columns) +
-           "\n)";
+           this->indexesSchema() + "\n)" + this->optionsSchema<false>() +
+           this->optionsSchema<true>();
+  }
+
+  /** Returns a statement splitting the `pmax` partition of a table
+   * partitioned by range, so that rows whose partitioning column is lower
+   * than `bound` (and not in a previous partition) go to partition `name`.
+   */
+  template <typename Bound>
+  std::string getAddPartitionQuery(std::string const& name,
+                                   Bound const& bound) const
+  {
+    static_assert(isPartitionedByRange(), "Table is not partitioned by range");
+    details::checkPartitionName(name);
+    return "ALTER TABLE `" + std::string{this->table_name.c_str()} +
+           "` REORGANIZE PARTITION `pmax` INTO (PARTITION `" + name +
+           "` VALUES LESS THAN (" + details::partitionBoundToString(bound) +
+           "), PARTITION `pmax` VALUES LESS THAN (MAXVALUE))";
+  }
+
+  /** Returns a statement dropping partition `name`, and its rows.
+   */
+  std::string getDropPartitionQuery(std::string const& name) const
+  {
+    static_assert(isPartitionedByRange(), "Table is not partitioned by range");
+    details::checkPartitionName(name);
+    return "ALTER TABLE `" + std::string{this->table_name.c_str()} +
+           "` DROP PARTITION `" + name + '`';
+  }
+
+  /** Returns true if the primary key and all unique keys include `Attr`.
+   */
+  template <auto Attr>
+  static constexpr bool uniqueKeysContain() noexcept
+  {
+    return uniqueIndexesContain<Attr>(static_cast<Indexes const*>(nullptr)) &&
+           (uniqueColumnContains<Columns, Attr>() && ...);
   }
 
   constexpr auto getName() const noexcept
@@ -89,61 +148,164 @@ public:
     return this->table_name;
   }
 
+  /** Returns true if `b` has the same table and column names.
+   *
+   * The SQL of queries on tables of the same type only depends on these.
+   */
+  constexpr bool hasSameNames(Table const& b) const noexcept
+  {
+    return this->table_name == b.table_name &&
+           this->hasSameColumnNames(b, std::index_sequence_for<Columns...>{});
+  }
+
   /** Returns a query to select all fields from the table.
    */
-  constexpr auto getAll(MYSQL& mysql) const
+  constexpr auto getAll(MYSQL& mysql, StatementCache* cache = nullptr) const
   {
     return GetAll<Table,
                   meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>(
-        mysql, *this);
+        mysql, *this, cache);
   }
 
   /** Returns a query to select some fields from the table.
    */
   template <auto... Attrs>
-  constexpr auto getAll(MYSQL& mysql) const
+  constexpr auto getAll(MYSQL& mysql, StatementCache* cache = nullptr) const
   {
     this->checkAttributes<Attrs...>();
-    return GetAll<Table, Attrs...>(mysql, *this);
+    return GetAll<Table, Attrs...>(mysql, *this, cache);
+  }
+
+  /** Returns a query computing an aggregate function over the table.
+   */
+  template <AggregateFunction F, auto... Attrs>
+  constexpr auto aggregate(MYSQL& mysql, StatementCache* cache = nullptr) const
+  {
+    this->checkAttributes<Attrs...>();
+    return Aggregate<Table, F, Attrs...>(mysql, *this, cache);
+  }
+
+  /** Returns a query selecting columns and aggregates from the table.
+   */
+  template <typename... Projections>
+  constexpr auto project(MYSQL& mysql, StatementCache* cache = nullptr) const
+  {
+    return Projection<Table, Projections...>(mysql, *this, cache);
   }
 
   template <auto... Attrs>
   constexpr auto insertAllBut(MYSQL& mysql,
-                              model_type const* model = nullptr) const
+                              model_type const* model = nullptr,
+                              StatementCache* cache = nullptr) const
   {
     this->checkAttributes<Attrs...>();
     using PackType = meta::RemoveValueOccurences_t<
         meta::ValuePack<
             meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>,
         meta::ValuePack<Attrs...>>;
-    return this->insert(PackType{}, mysql, model);
+    return this->insert(PackType{}, mysql, model, cache);
   }
 
   /** Returns a query to insert all fields into the table.
    */
-  constexpr auto insert(MYSQL& mysql, model_type const* model = nullptr) const
+  constexpr auto insert(MYSQL& mysql,
+                        model_type const* model = nullptr,
+                        StatementCache* cache = nullptr) const
   {
     return Insert<Table,
                   meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>(
-        mysql, *this, model);
+        mysql, *this, model, cache);
   }
 
   template <auto... Vs>
   constexpr auto insert(meta::ValuePack<Vs...>,
                         MYSQL& mysql,
-                        model_type const* model) const
+                        model_type const* model,
+                        StatementCache* cache = nullptr) const
   {
     this->checkAttributes<Vs...>();
-    return this->insert<Vs...>(mysql, model);
+    return this->insert<Vs...>(mysql, model, cache);
   }
 
   /** Returns a query to insert some fields into the table.
    */
   template <auto... Attrs>
-  constexpr auto insert(MYSQL& mysql, model_type const* model = nullptr) const
+  constexpr auto insert(MYSQL& mysql,
+                        model_type const* model = nullptr,
+                        StatementCache* cache = nullptr) const
   {
     this->checkAttributes<Attrs...>();
-    return Insert<Table, Attrs...>(mysql, *this, model);
+    return Insert<Table, Attrs...>(mysql, *this, model, cache);
+  }
+
+  /** Inserts the models of a range, `NROWS` rows per query.
+   *
+   * If no attribute is given, all fields are inserted.
+   * The last rows are inserted with smaller batches (`NROWS / 2`, `NROWS / 4`,
+   * ...). Each batch size uses one statement, executed as many times as
+   * needed.
+   */
+  template <std::size_t NROWS, auto... Attrs, typename Iterator>
+  void insertRange(MYSQL& mysql,
+                   Iterator first,
+                   Iterator last,
+                   StatementCache* cache = nullptr) const
+  {
+    static_assert(
+        std::is_same_v<typename std::iterator_traits<Iterator>::value_type,
+                       model_type>,
+        "Iterator does not refer to the model of the table");
+    if constexpr (sizeof...(Attrs) == 0)
+      this->insertRange<NROWS>(
+          meta::ValuePack<
+              meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>{},
+          mysql,
+          first,
+          last,
+          cache);
+    else
+    {
+      this->checkAttributes<Attrs...>();
+      auto remaining = static_cast<std::size_t>(std::distance(first, last));
+      if (remaining >= NROWS)
+      {
+        auto stmt =
+            InsertBatch<Table, NROWS, Attrs...>{mysql, *this, cache}.build();
+        for (; remaining >= NROWS; remaining -= NROWS)
+        {
+          stmt.bindInsertRange(first);
+          stmt.execute();
+          std::advance(first, NROWS);
+        }
+      }
+      if constexpr (NROWS > 1)
+        if (remaining > 0)
+          this->insertRange<NROWS / 2, Attrs...>(mysql, first, last, cache);
+    }
+  }
+
+  template <std::size_t NROWS, auto... Vs, typename Iterator>
+  void insertRange(meta::ValuePack<Vs...>,
+                   MYSQL& mysql,
+                   Iterator first,
+                   Iterator last,
+                   StatementCache* cache = nullptr) const
+  {
+    this->insertRange<NROWS, Vs...>(mysql, first, last, cache);
+  }
+
+  template <std::size_t NROWS, auto... Attrs, typename Iterator>
+  void insertRangeAllBut(MYSQL& mysql,
+                         Iterator first,
+                         Iterator last,
+                         StatementCache* cache = nullptr) const
+  {
+    this->checkAttributes<Attrs...>();
+    using PackType = meta::RemoveValueOccurences_t<
+        meta::ValuePack<
+            meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>,
+        meta::ValuePack<Attrs...>>;
+    this->insertRange<NROWS>(PackType{}, mysql, first, last, cache);
   }
 
   /** Returns a CompileString with the select query for specified fields.
@@ -161,7 +323,45 @@ public:
   constexpr auto insertCS() const
   {
     this->checkAttributes<Attrs...>();
-    return InsertQueryBuilder<void, Attrs...>::insert(*this);
+    return InsertQueryBuilder<1, Attrs...>::insert(*this);
+  }
+
+  /** Returns a CompileString with the insert query for `NROWS` rows.
+   */
+  template <std::size_t NROWS, auto... Attrs>
+  constexpr auto insertBatchCS() const
+  {
+    this->checkAttributes<Attrs...>();
+    return InsertQueryBuilder<NROWS, Attrs...>::insert(*this);
+  }
+
+  /** Returns a CompileString with the `LOAD DATA` query for specified fields.
+   *
+   * The file name is irrelevant: data is provided by a local infile handler.
+   * Text is decoded as `utf8mb4`, whatever the charset of the database.
+   */
+  template <auto... Attrs>
+  constexpr auto loadDataCS() const
+  {
+    this->checkAttributes<Attrs...>();
+    return "LOAD DATA LOCAL INFILE 'mysql_orm' INTO TABLE `" +
+           this->table_name + "` CHARACTER SET utf8mb4 (" +
+           details::ColumnNamesJoiner<Table, Attrs...>::join(*this) + ')';
+  }
+
+  /** Returns a query to load a range of models with `LOAD DATA`.
+   */
+  template <typename Iterator>
+  auto bulkLoad(MYSQL& mysql, Iterator first, Iterator last) const
+  {
+    static_assert(
+        std::is_same_v<typename std::iterator_traits<Iterator>::value_type,
+                       model_type>,
+        "Iterator does not refer to the model of the table");
+    return BulkLoad<Table,
+                    Iterator,
+                    meta::MapValue_v<meta::ColumnAttributeGetter, Columns>...>(
+        mysql, *this, first, last);
   }
 
   /** Returns the column associated to the specified attribute.
@@ -178,6 +378,15 @@ public:
   }
 
 private:
+  template <std::size_t... Is>
+  constexpr bool hasSameColumnNames(Table const& b,
+                                    std::index_sequence<Is...>) const noexcept
+  {
+    return ((std::get<Is>(this->columns).getName() ==
+             std::get<Is>(b.columns).getName()) &&
+            ...);
+  }
+
   template <std::size_t N>
   using CompileString = compile_string::CompileString<N>;
 
@@ -190,6 +399,99 @@ private:
                   "Failed to find attribute");
   }
 
+  template <auto... Attrs>
+  constexpr void checkPackAttributes(meta::ValuePack<Attrs...> const*) const
+      noexcept
+  {
+    this->checkAttributes<Attrs...>();
+  }
+
+  template <typename Column>
+  using ColumnConstraints_t = decltype(
+      columnConstraintsFromPack(typename Column::ConstraintsPack{}));
+
+  template <typename... Idxs>
+  constexpr void checkIndexes(std::tuple<Idxs...> const*) const noexcept
+  {
+    (this->checkPackAttributes(
+         static_cast<typename Idxs::attributes_type const*>(nullptr)),
+     ...);
+    constexpr auto nb_primary_keys =
+        (std::size_t{Idxs::primary_key} + ... + 0) +
+        (std::size_t{ColumnConstraints_t<Columns>::primary_key()} + ... + 0);
+    static_assert(nb_primary_keys <= 1, "Primary key specified multiple times");
+  }
+
+  template <typename Column, auto Attr>
+  static constexpr bool uniqueColumnContains() noexcept
+  {
+    using Constraints_t = ColumnConstraints_t<Column>;
+    return !(Constraints_t::unique() || Constraints_t::primary_key()) ||
+           meta::TypeValEquals_v<Column::attribute, Attr>;
+  }
+
+  template <auto Attr, typename... Idxs>
+  static constexpr bool uniqueIndexesContain(
+      std::tuple<Idxs...> const*) noexcept
+  {
+    return ((!Idxs::unique ||
+             meta::ValuePackContains_v<Attr,
+                                       typename Idxs::attributes_type>) &&
+            ...);
+  }
+
+  template <typename... Opts>
+  static constexpr bool isPartitionedByRangeImpl(
+      std::tuple<Opts...> const*) noexcept
+  {
+    return (details::IsRangePartition<Opts>::value || ...);
+  }
+
+  static constexpr bool isPartitionedByRange() noexcept
+  {
+    return isPartitionedByRangeImpl(static_cast<Options const*>(nullptr));
+  }
+
+  /** Returns the table options (if not `PARTITIONS`) or the partitioning
+   * clause (if `PARTITIONS`), preceded by a separator.
+   */
+  template <bool PARTITIONS>
+  constexpr auto optionsSchema() const
+  {
+    if constexpr (std::tuple_size_v<Options> == 0)
+      return CompileString<0>{""};
+    else
+      return tupleFoldl(
+          [&](auto const& acc, auto const& option) {
+            using Option_t = std::remove_cv_t<
+                std::remove_reference_t<decltype(option)>>;
+            if constexpr ((Option_t::kind == TableOptionKind::Partition) !=
+                          PARTITIONS)
+              return acc;
+            else if constexpr (PARTITIONS)
+              return acc + '\n' + option.getSchema(*this);
+            else
+              return acc + ' ' + option.getSchema(*this);
+          },
+          CompileString<0>{""},
+          this->options);
+  }
+
+  /** Returns the definitions of the indexes, each preceded by a comma.
+   */
+  constexpr auto indexesSchema() const
+  {
+    if constexpr (std::tuple_size_v<Indexes> == 0)
+      return CompileString<0>{""};
+    else
+      return tupleFoldl(
+          [&](auto const& acc, auto const& index) {
+            return acc + ",\n  " + index.getSchema(*this);
+          },
+          CompileString<0>{""},
+          this->indexes);
+  }
+
   /** Returns a CompileString with a SELECT query for the given attributes.
    */
   template <typename Dummy = void, auto... Attrs>
@@ -203,49 +505,108 @@ private:
   };
 
   /** Returns a CompileString with a INSERT query for the given attributes.
+   *
+   * The query has `NROWS` lists of values.
    */
-  template <typename Dummy = void, auto... Attrs>
+  template <std::size_t NROWS, auto... Attrs>
   struct InsertQueryBuilder
   {
     constexpr static auto insert(Table const& t)
     {
+      auto const row =
+          '(' +
+          applyN<sizeof...(Attrs)>(
+              [](auto const& acc) {
+                if constexpr (std::is_same_v<
+                                  compile_string::CompileString<0> const&,
+                                  decltype(acc)>)
+                  return compile_string::CompileString{"?"};
+                else
+                  return acc + ", ?";
+              },
+              CompileString<0>{""}) +
+          ')';
       return "INSERT INTO `" + t.table_name + '`' + ' ' + '(' +
              details::ColumnNamesJoiner<Table, Attrs...>::join(t) +
-             ") VALUES (" +
-             applyN<sizeof...(Attrs)>(
-                 [](auto const& acc) {
-                   if constexpr (std::is_same_v<
-                                     compile_string::CompileString<0> const&,
-                                     decltype(acc)>)
-                     return compile_string::CompileString{"?"};
-                   else
-                     return acc + ", ?";
-                 },
-                 CompileString<0>{""}) +
-             ')';
+             ") VALUES " +
+             applyN<NROWS - 1>(
+                 [&](auto const& acc) { return acc + ", " + row; }, row);
     }
   };
 
   CompileString<NAME_SIZE - 1> table_name;
   std::tuple<Columns...> columns;
+  Indexes indexes;
+  Options options;
+};
+
+namespace details
+{
+enum class TableArgKind
+{
+  Column,
+  Index,
+  Option
 };
 
+template <typename Arg>
+constexpr auto tableArgKind() noexcept
+{
+  if constexpr (IsIndex_v<Arg>)
+    return TableArgKind::Index;
+  else if constexpr (IsTableOption_v<Arg>)
+    return TableArgKind::Option;
+  else
+    return TableArgKind::Column;
+}
+
+/** Returns a tuple with `arg` if it is of the given kind, or an empty tuple.
+ */
+template <TableArgKind KIND, typename Arg>
+constexpr auto selectTableArgs(Arg&& arg)
+{
+  using Arg_t = std::remove_cv_t<std::remove_reference_t<Arg>>;
+  if constexpr (tableArgKind<Arg_t>() == KIND)
+    return std::tuple<Arg_t>{std::forward<Arg>(arg)};
+  else
+    return std::tuple<>{};
+}
+}
+
 /** Helper function to create a table.
  *
  * Used the following way:
  * ```
  * make_table(make_column<&Model::Field1>("field1", PrimaryKey{}),
  *            make_column<&Model::Field2>("field2", NotNull{}),
- *            make_column<&Model::Field3>("field3")))
+ *            make_column<&Model::Field3>("field3"),
+ *            make_index<&Model::Field2, &Model::Field3>("field2_field3"))
  * ```
  *
+ * Indexes (see `make_index`) and table options (see TableOptions.hpp) may be
+ * given anywhere among the columns.
+ *
  * The return value is left opaque to the user and should at best be stored in
  * a type-deduced value (`auto`).
  */
-template <typename... Columns, std::size_t name_size>
-constexpr auto make_table(char const (&name)[name_size], Columns&&... cols)
+template <typename... Args, std::size_t name_size>
+constexpr auto make_table(char const (&name)[name_size], Args&&... args)
 {
-  return Table<name_size, Columns...>{name, std::forward<Columns>(cols)...};
+  using details::TableArgKind;
+  auto indexes = std::tuple_cat(
+      details::selectTableArgs<TableArgKind::Index>(std::as_const(args))...);
+  auto options = std::tuple_cat(
+      details::selectTableArgs<TableArgKind::Option>(std::as_const(args))...);
+  return std::apply(
+      [&](auto&&... cols) {
+        return Table<name_size,
+                     decltype(indexes),
+                     decltype(options),
+                     std::remove_reference_t<decltype(cols)>...>{
+            name, std::move(indexes), std::move(options), std::move(cols)...};
+      },
+      std::tuple_cat(details::selectTableArgs<TableArgKind::Column>(
+          std::forward<Args>(args))...));
 }
 }
 
@@ -0,0 +1,375 @@
+#ifndef MYSQL_ORM_TABLEOPTIONS_HPP_
+#define MYSQL_ORM_TABLEOPTIONS_HPP_
+
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <CompileString/CompileString.hpp>
+#include <CompileString/ToString.hpp>
+
+#include <mysql_orm/Chrono.hpp>
+#include <mysql_orm/meta/AttributePtrDissector.hpp>
+#include <mysql_orm/meta/IsChrono.hpp>
+#include <mysql_orm/meta/LiftOptional.hpp>
+#include <mysql_orm/meta/Pack.hpp>
+
+namespace mysql_orm
+{
+enum class TableOptionKind
+{
+  Engine,
+  RowFormat,
+  KeyBlockSize,
+  Partition
+};
+
+enum class StorageEngine
+{
+  InnoDB,
+  MyISAM,
+  Memory,
+  Archive
+};
+
+enum class RowFormatType
+{
+  Default,
+  Dynamic,
+  Fixed,
+  Compressed,
+  Redundant,
+  Compact
+};
+
+/** Table options.
+ *
+ * Options are given to `make_table` along with the columns, and are emitted
+ * after the column definitions in `CREATE TABLE`. Each kind of option may be
+ * given at most once.
+ *
+ * Each option defines:
+ *   - `kind`: The `TableOptionKind` of the option.
+ *   - `getSchema(table)`: The SQL of the option.
+ *   - `check<Table>()`: Compile-time checks against the table.
+ */
+template <StorageEngine ENGINE>
+struct Engine
+{
+  static inline constexpr auto kind{TableOptionKind::Engine};
+  static inline constexpr auto engine{ENGINE};
+
+  template <typename Table>
+  static constexpr auto getSchema(Table const&)
+  {
+    if constexpr (ENGINE == StorageEngine::InnoDB)
+      return compile_string::CompileString{"ENGINE=InnoDB"};
+    else if constexpr (ENGINE == StorageEngine::MyISAM)
+      return compile_string::CompileString{"ENGINE=MyISAM"};
+    else if constexpr (ENGINE == StorageEngine::Memory)
+      return compile_string::CompileString{"ENGINE=MEMORY"};
+    else
+      return compile_string::CompileString{"ENGINE=ARCHIVE"};
+  }
+
+  template <typename Table>
+  static constexpr void check() noexcept
+  {
+  }
+};
+
+template <RowFormatType ROW_FORMAT>
+struct RowFormat
+{
+  static inline constexpr auto kind{TableOptionKind::RowFormat};
+  static inline constexpr auto row_format{ROW_FORMAT};
+
+  template <typename Table>
+  static constexpr auto getSchema(Table const&)
+  {
+    if constexpr (ROW_FORMAT == RowFormatType::Default)
+      return compile_string::CompileString{"ROW_FORMAT=DEFAULT"};
+    else if constexpr (ROW_FORMAT == RowFormatType::Dynamic)
+      return compile_string::CompileString{"ROW_FORMAT=DYNAMIC"};
+    else if constexpr (ROW_FORMAT == RowFormatType::Fixed)
+      return compile_string::CompileString{"ROW_FORMAT=FIXED"};
+    else if constexpr (ROW_FORMAT == RowFormatType::Compressed)
+      return compile_string::CompileString{"ROW_FORMAT=COMPRESSED"};
+    else if constexpr (ROW_FORMAT == RowFormatType::Redundant)
+      return compile_string::CompileString{"ROW_FORMAT=REDUNDANT"};
+    else
+      return compile_string::CompileString{"ROW_FORMAT=COMPACT"};
+  }
+
+  template <typename Table>
+  static constexpr void check() noexcept
+  {
+  }
+};
+
+/** Page size of compressed InnoDB tables, in kilobytes.
+ */
+template <std::size_t SIZE>
+struct KeyBlockSize
+{
+  static_assert(SIZE == 1 || SIZE == 2 || SIZE == 4 || SIZE == 8 ||
+                    SIZE == 16,
+                "KEY_BLOCK_SIZE must be 1, 2, 4, 8 or 16");
+
+  static inline constexpr auto kind{TableOptionKind::KeyBlockSize};
+
+  template <typename Table>
+  static constexpr auto getSchema(Table const&)
+  {
+    return "KEY_BLOCK_SIZE=" + compile_string::toString<SIZE>();
+  }
+
+  template <typename Table>
+  static constexpr void check() noexcept
+  {
+  }
+};
+
+namespace details
+{
+/** Checks that the table can be partitioned on `Attr`.
+ *
+ * MySQL requires the partitioning column to be part of every unique key of
+ * the table, including the primary key. Tables with an identifier may thus
+ * be partitioned with a primary key spanning both columns (see
+ * `make_primary_key`).
+ */
+template <typename Table, auto Attr>
+constexpr void checkPartitionColumn() noexcept
+{
+  static_assert(
+      meta::ValuePackContains_v<Attr, typename Table::attributes_type>,
+      "Failed to find attribute");
+  static_assert(Table::template uniqueKeysContain<Attr>(),
+                "Partition column must be part of the primary key and of "
+                "unique keys");
+}
+}
+
+/** Partitions the table by ranges of the values of `Attr`.
+ *
+ * The table is created with a single `pmax` partition holding all rows.
+ * Partitions are then added with `Database::addPartition`, which splits
+ * `pmax`, and removed with `Database::dropPartition`.
+ */
+template <auto Attr>
+struct PartitionByRange
+{
+  static inline constexpr auto kind{TableOptionKind::Partition};
+  static inline constexpr auto attribute = Attr;
+
+  template <typename Table>
+  static constexpr auto getSchema(Table const& t)
+  {
+    return "PARTITION BY RANGE COLUMNS(`" +
+           t.template getColumn<Attr>().getName() +
+           "`) (PARTITION `pmax` VALUES LESS THAN (MAXVALUE))";
+  }
+
+  template <typename Table>
+  static constexpr void check() noexcept
+  {
+    details::checkPartitionColumn<Table, Attr>();
+  }
+};
+
+/** Partitions the table into `NB_PARTITIONS` by a hash of `Attr`, which must
+ * be an integer.
+ */
+template <auto Attr, std::size_t NB_PARTITIONS>
+struct PartitionByHash
+{
+  static_assert(NB_PARTITIONS > 0, "Tables need at least one partition");
+  static_assert(
+      std::is_integral_v<
+          meta::LiftOptional_t<meta::AttributeGetter_t<decltype(Attr)>>>,
+      "Hash partitioning needs an integer column");
+
+  static inline constexpr auto kind{TableOptionKind::Partition};
+  static inline constexpr auto attribute = Attr;
+
+  template <typename Table>
+  static constexpr auto getSchema(Table const& t)
+  {
+    return "PARTITION BY HASH(`" + t.template getColumn<Attr>().getName() +
+           "`) PARTITIONS " + compile_string::toString<NB_PARTITIONS>();
+  }
+
+  template <typename Table>
+  static constexpr void check() noexcept
+  {
+    details::checkPartitionColumn<Table, Attr>();
+  }
+};
+
+namespace details
+{
+template <typename T>
+struct IsTableOption : std::false_type
+{
+};
+
+template <StorageEngine ENGINE>
+struct IsTableOption<Engine<ENGINE>> : std::true_type
+{
+};
+
+template <RowFormatType ROW_FORMAT>
+struct IsTableOption<RowFormat<ROW_FORMAT>> : std::true_type
+{
+};
+
+template <std::size_t SIZE>
+struct IsTableOption<KeyBlockSize<SIZE>> : std::true_type
+{
+};
+
+template <auto Attr>
+struct IsTableOption<PartitionByRange<Attr>> : std::true_type
+{
+};
+
+template <auto Attr, std::size_t NB_PARTITIONS>
+struct IsTableOption<PartitionByHash<Attr, NB_PARTITIONS>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr auto IsTableOption_v = IsTableOption<T>::value;
+
+template <typename T>
+struct IsRangePartition : std::false_type
+{
+};
+
+template <auto Attr>
+struct IsRangePartition<PartitionByRange<Attr>> : std::true_type
+{
+};
+
+/** Returns the number of options of the given kind.
+ */
+template <TableOptionKind KIND, typename... Options>
+constexpr std::size_t countTableOptions() noexcept
+{
+  return ((Options::kind == KIND ? 1 : 0) + ... + 0);
+}
+
+/** Checks the options of a table against each other and against the table.
+ */
+template <typename Table, typename... Options>
+constexpr void checkTableOptions(std::tuple<Options...> const*) noexcept
+{
+  static_assert(countTableOptions<TableOptionKind::Engine, Options...>() <= 1,
+                "Engine specified multiple times");
+  static_assert(
+      countTableOptions<TableOptionKind::RowFormat, Options...>() <= 1,
+      "Row format specified multiple times");
+  static_assert(
+      countTableOptions<TableOptionKind::KeyBlockSize, Options...>() <= 1,
+      "Key block size specified multiple times");
+  static_assert(
+      countTableOptions<TableOptionKind::Partition, Options...>() <= 1,
+      "Partitioning specified multiple times");
+
+  constexpr auto non_innodb =
+      ((Options::kind == TableOptionKind::Engine &&
+        !std::is_same_v<Options, Engine<StorageEngine::InnoDB>>) ||
+       ...);
+  constexpr auto compressed =
+      (std::is_same_v<Options, RowFormat<RowFormatType::Compressed>> || ...);
+  constexpr auto other_row_format =
+      ((Options::kind == TableOptionKind::RowFormat &&
+        !std::is_same_v<Options, RowFormat<RowFormatType::Compressed>>) ||
+       ...);
+  constexpr auto key_block_size =
+      countTableOptions<TableOptionKind::KeyBlockSize, Options...>() > 0;
+  static_assert(!(compressed || key_block_size) || !non_innodb,
+                "Compressed tables need the InnoDB engine");
+  static_assert(!key_block_size || !other_row_format,
+                "KEY_BLOCK_SIZE needs the COMPRESSED row format");
+
+  (Options::template check<Table>(), ...);
+}
+
+/** Formats the upper bound of a range partition.
+ *
+ * Time points are formatted as values of their column: `DATE`, `DATETIME` or
+ * `DATETIME(6)` (see `getFieldSQLType`).
+ */
+template <typename T>
+std::string partitionBoundToString(T const& bound)
+{
+  if constexpr (std::is_same_v<T, std::tm>)
+  {
+    char buf[sizeof("'YYYY-MM-DD HH:MM:SS'")];
+    // Years out of [0, 9999] do not fit, and leave `buf` undefined.
+    if (!std::strftime(buf, sizeof(buf), "'%Y-%m-%d %H:%M:%S'", &bound))
+      throw std::invalid_argument("Invalid partition bound");
+    return buf;
+  }
+  else if constexpr (meta::IsSysTime_v<T>)
+  {
+    auto const time = details::toMySQLTime(bound);
+    // Years before 0 wrap around, since `year` is unsigned.
+    if (time.year > 9999)
+      throw std::invalid_argument("Invalid partition bound");
+    char buf[sizeof("'YYYY-MM-DD HH:MM:SS.ffffff'")];
+    if constexpr (details::is_date_v<T>)
+      std::snprintf(buf,
+                    sizeof(buf),
+                    "'%04u-%02u-%02u'",
+                    time.year,
+                    time.month,
+                    time.day);
+    else if constexpr (details::has_fractional_seconds_v<T>)
+      std::snprintf(buf,
+                    sizeof(buf),
+                    "'%04u-%02u-%02u %02u:%02u:%02u.%06lu'",
+                    time.year,
+                    time.month,
+                    time.day,
+                    time.hour,
+                    time.minute,
+                    time.second,
+                    time.second_part);
+    else
+      std::snprintf(buf,
+                    sizeof(buf),
+                    "'%04u-%02u-%02u %02u:%02u:%02u'",
+                    time.year,
+                    time.month,
+                    time.day,
+                    time.hour,
+                    time.minute,
+                    time.second);
+    return buf;
+  }
+  else
+  {
+    static_assert(std::is_integral_v<T>,
+                  "Partition bounds must be integers, std::tm or time points");
+    return std::to_string(bound);
+  }
+}
+
+/** Checks that `name` can be enclosed in backquotes.
+ */
+inline void checkPartitionName(std::string const& name)
+{
+  if (name.empty() || name.find('`') != std::string::npos || name == "pmax")
+    throw std::invalid_argument("Invalid partition name: " + name);
+}
+}
+}
+
+#endif /* !MYSQL_ORM_TABLEOPTIONS_HPP_ */
@@ -20,8 +20,10 @@ public:
   using table_type = Table;
   static inline constexpr auto query_type{QueryType::Update};
 
-  constexpr Update(MYSQL& mysql, Table const& t) noexcept
-    : mysql_handle{&mysql}, table{&t}
+  constexpr Update(MYSQL& mysql,
+                   Table const& t,
+                   StatementCache* cache = nullptr) noexcept
+    : mysql_handle{&mysql}, table{&t}, stmt_cache{cache}
   {
   }
   constexpr Update(Update const& b) noexcept = default;
@@ -49,6 +51,11 @@ public:
     return this->build().execute();
   }
 
+  constexpr StatementCache* getStatementCache() const noexcept
+  {
+    return this->stmt_cache;
+  }
+
   constexpr static size_t getNbOutputSlots() noexcept
   {
     return 0;
@@ -74,6 +81,7 @@ private:
   // incomplete.
   MYSQL* mysql_handle;
   Table const* table;
+  StatementCache* stmt_cache;
 };
 }
 
@@ -6,7 +6,10 @@
 
 #include <CompileString/CompileString.hpp>
 
+#include <mysql_orm/GroupBy.hpp>
 #include <mysql_orm/Limit.hpp>
+#include <mysql_orm/OrderBy.hpp>
+#include <mysql_orm/QueryType.hpp>
 #include <mysql_orm/Statement.hpp>
 #include <mysql_orm/WhereConditionDSL.hpp>
 
@@ -45,10 +48,11 @@ public:
  * The class continues a `Select` or `Update` query.
  * Takes a condition as parameter, which must be an `OperatorClosure`.
  *
- * `buildquery` returns the SQL query as a std::string.
+ * `buildquery` returns a view of the SQL query.
  * `build` returns a `Statement`, which can later be `execute()`d.
  *
- * The `operator()` can be used to continue the query (Limit).
+ * The `operator()` can be used to continue the query (GroupBy, OrderBy,
+ * Limit).
  *
  * TODO(ethiraric): Check that all columns from the conditions refer to the
  * model.
@@ -86,9 +90,33 @@ public:
                                          *this->table);
   }
 
+  template <auto Attr, auto... Attrs>
+  constexpr auto operator()(GroupBy<Attr, Attrs...> group)
+  {
+    using ContinuationType = QueryContinuation<Query, WhereQueryImpl>;
+    return GroupByQuery<ContinuationType, GroupBy<Attr, Attrs...>>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(group)};
+  }
+
+  template <auto Attr, typename Direction>
+  constexpr auto operator()(OrderBy<Attr, Direction> order)
+  {
+    using ContinuationType = QueryContinuation<Query, WhereQueryImpl>;
+    return OrderByQuery<ContinuationType, OrderBy<Attr, Direction>>{
+        *this->mysql_handle,
+        static_cast<ContinuationType&>(*this),
+        *this->table,
+        std::move(order)};
+  }
+
   template <typename Limit>
   constexpr auto operator()(Limit limit)
   {
+    static_assert(Query::query_type != QueryType::Aggregate,
+                  "Limit does not limit the rows of aggregate queries");
     using ContinuationType = QueryContinuation<Query, WhereQueryImpl>;
     return LimitQuery<ContinuationType, Limit>{
         *this->mysql_handle,
@@ -329,7 +329,7 @@ struct c
   template <auto other_attr>                                                  \
   auto operator op(c<other_attr> const& rhs) const                            \
   {                                                                           \
-    return OperatorClosure<c, decltype(rhs), OperatorType::type>{*this, rhs}; \
+    return OperatorClosure<c, c<other_attr>, OperatorType::type>{*this, rhs}; \
   }                                                                           \
                                                                               \
   template <typename T>                                                       \
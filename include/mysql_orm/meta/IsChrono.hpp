@@ -0,0 +1,43 @@
+#ifndef MYSQL_ORM_META_ISCHRONO_HPP_
+#define MYSQL_ORM_META_ISCHRONO_HPP_
+
+#include <chrono>
+#include <type_traits>
+
+#include <mysql_orm/meta/IsTemplateInstanciation.hpp>
+
+namespace mysql_orm
+{
+namespace meta
+{
+/** Metafunction returning true if T is an instanciation of
+ * std::chrono::duration.
+ */
+template <typename T>
+struct IsDuration : IsTemplateInstanciation<std::chrono::duration, T>
+{
+};
+
+template <typename T>
+inline constexpr auto IsDuration_v = IsDuration<T>::value;
+
+/** Metafunction returning true if T is a std::chrono::time_point of
+ * std::chrono::system_clock.
+ */
+template <typename T>
+struct IsSysTime : std::false_type
+{
+};
+
+template <typename Duration>
+struct IsSysTime<std::chrono::time_point<std::chrono::system_clock, Duration>>
+  : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr auto IsSysTime_v = IsSysTime<T>::value;
+}
+}
+
+#endif /* !MYSQL_ORM_META_ISCHRONO_HPP_ */
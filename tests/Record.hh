@@ -6,6 +6,7 @@
 #include <ostream>
 #include <string>
 
+#include <mysql_orm/Chrono.hpp>
 #include <mysql_orm/Column.hpp>
 
 struct Record
@@ -79,6 +80,33 @@ inline std::ostream& operator<<(std::ostream& out, RecordWithTime const& record)
   return out;
 }
 
+struct RecordWithChrono
+{
+  mysql_orm::id_t id;
+  mysql_orm::sys_days date;
+  mysql_orm::sys_seconds time;
+  mysql_orm::sys_time<std::chrono::microseconds> precise_time;
+  std::chrono::seconds duration;
+
+  bool operator==(RecordWithChrono const& b) const noexcept
+  {
+    return this->id == b.id && this->date == b.date && this->time == b.time &&
+           this->precise_time == b.precise_time &&
+           this->duration == b.duration;
+  }
+};
+
+inline std::ostream& operator<<(std::ostream& out,
+                                RecordWithChrono const& record)
+{
+  out << "RecordWithChrono{" << record.id << ','
+      << record.date.time_since_epoch().count() << ','
+      << record.time.time_since_epoch().count() << ','
+      << record.precise_time.time_since_epoch().count() << ','
+      << record.duration.count() << '}';
+  return out;
+}
+
 struct LargeRecord
 {
   mysql_orm::id_t id;
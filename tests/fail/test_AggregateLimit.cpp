@@ -0,0 +1,23 @@
+#include <mysql_orm/Database.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::Where;
+
+int main()
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto database = make_database(connection, table_records);
+  database.count<Record>()(Where{c<&Record::i>{} > 1})(Limit<1>{})();
+}
@@ -0,0 +1,16 @@
+#include <mysql_orm/Table.hpp>
+
+#include <Record.hh>
+
+using mysql_orm::make_column;
+using mysql_orm::make_index;
+using mysql_orm::make_table;
+
+int main()
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::s>("s"),
+                                  make_index<&Record::s>("s"));
+  (void)table_records.getSchema();
+}
@@ -0,0 +1,24 @@
+#include <mysql_orm/Database.hpp>
+
+#include <vector>
+
+#include <Record.hh>
+
+using mysql_orm::BatchSize;
+using mysql_orm::Connection;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+
+int main()
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto database = make_database(connection, table_records);
+  auto const records = std::vector<Record>{};
+  database.insert(records.begin(), records.end(), BatchSize<2048>{});
+}
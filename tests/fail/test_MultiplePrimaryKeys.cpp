@@ -0,0 +1,17 @@
+#include <mysql_orm/Table.hpp>
+
+#include <Record.hh>
+
+using mysql_orm::make_column;
+using mysql_orm::make_primary_key;
+using mysql_orm::make_table;
+using mysql_orm::PrimaryKey;
+
+int main()
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id", PrimaryKey{}),
+                                  make_column<&Record::i>("i"),
+                                  make_primary_key<&Record::id, &Record::i>());
+  (void)table_records;
+}
@@ -0,0 +1,17 @@
+#include <mysql_orm/Table.hpp>
+
+#include <Record.hh>
+
+using mysql_orm::make_column;
+using mysql_orm::make_table;
+using mysql_orm::PartitionByHash;
+using mysql_orm::PrimaryKey;
+
+int main()
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id", PrimaryKey{}),
+                                  make_column<&Record::i>("i"),
+                                  PartitionByHash<&Record::i, 4>{});
+  (void)table_records;
+}
@@ -0,0 +1,99 @@
+#include <mysql_orm/Aggregate.hpp>
+
+#include <optional>
+#include <type_traits>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::Where;
+
+TEST_CASE("[Aggregate] Aggregate buildquery", "[Aggregate]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  CHECK(d.count<Record>().buildquery() == "SELECT COUNT(*) FROM `records`");
+  CHECK(d.sum<&Record::i>().buildquery() == "SELECT SUM(`i`) FROM `records`");
+  CHECK(d.min<&Record::i>().buildquery() == "SELECT MIN(`i`) FROM `records`");
+  CHECK(d.max<&Record::s>().buildquery() == "SELECT MAX(`s`) FROM `records`");
+  CHECK(d.avg<&Record::i>().buildquery() == "SELECT AVG(`i`) FROM `records`");
+  CHECK(d.count<Record>()(Where{c<&Record::i>{} > 1}).buildquery() ==
+        "SELECT COUNT(*) FROM `records` WHERE `i`>?");
+}
+
+TEST_CASE("[Aggregate] Aggregate results", "[Aggregate]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+
+  SECTION("Result types")
+  {
+    static_assert(std::is_same_v<decltype(d.count<Record>()()),
+                                 unsigned long long>);
+    static_assert(std::is_same_v<decltype(d.sum<&Record::i>()()),
+                                 std::optional<long long>>);
+    static_assert(
+        std::is_same_v<decltype(d.max<&Record::i>()()), std::optional<int>>);
+    static_assert(std::is_same_v<decltype(d.min<&Record::s>()()),
+                                 std::optional<std::string>>);
+    static_assert(std::is_same_v<decltype(d.avg<&Record::i>()()),
+                                 std::optional<double>>);
+  }
+
+  SECTION("Whole table")
+  {
+    CHECK(d.count<Record>()() == 3);
+    CHECK(d.sum<&Record::i>()() == 7);
+    CHECK(d.min<&Record::i>()() == 1);
+    CHECK(d.max<&Record::i>()() == 4);
+    CHECK(d.max<&Record::s>()() == "two");
+    auto const avg = d.avg<&Record::i>()();
+    REQUIRE(avg);
+    CHECK(*avg == Catch::Approx(7.0 / 3));
+  }
+
+  SECTION("With where")
+  {
+    CHECK(d.count<Record>()(Where{c<&Record::i>{} > 1})() == 2);
+    CHECK(d.sum<&Record::i>()(Where{c<&Record::i>{} > 1})() == 6);
+  }
+
+  SECTION("Empty set")
+  {
+    CHECK(d.count<Record>()(Where{c<&Record::i>{} > 10})() == 0);
+    CHECK(!d.sum<&Record::i>()(Where{c<&Record::i>{} > 10})());
+    CHECK(!d.max<&Record::s>()(Where{c<&Record::i>{} > 10})());
+  }
+
+  SECTION("Connection is usable afterwards")
+  {
+    CHECK(d.count<Record>()() == 3);
+    CHECK(d.getAll<Record>()().size() == 3);
+  }
+}
@@ -0,0 +1,100 @@
+#include <mysql_orm/AsyncQuery.hpp>
+
+#include <exception>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/EventLoop.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::ConnectionOptions;
+using mysql_orm::EventLoop;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::ref;
+using mysql_orm::Set;
+using mysql_orm::Where;
+
+TEST_CASE("[AsyncQuery] Queries on an event loop", "[AsyncQuery]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto options = ConnectionOptions{};
+  options.nonblocking = true;
+  auto connection_a = Connection{
+      "localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db", options};
+  auto connection_b = Connection{
+      "localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db", options};
+  auto a = make_database(connection_a, table_records);
+  auto b = make_database(connection_b, table_records);
+
+  a.recreate();
+  a.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+
+  auto loop = EventLoop{};
+
+  SECTION("Select")
+  {
+    auto called = false;
+    a.getAll<Record>().async(
+        loop, [&](std::exception_ptr error, std::vector<Record> rows) {
+          called = true;
+          CHECK(!error);
+          REQUIRE(rows.size() == 3);
+          CHECK(rows[2].s == "four");
+        });
+    loop.run();
+    CHECK(called);
+    CHECK(loop.pending() == 0);
+  }
+
+  SECTION("Queries in flight on several connections")
+  {
+    auto i = 2;
+    auto rows_a = std::vector<Record>{};
+    auto rows_b = std::vector<Record>{};
+    a.getAll<Record>()(Where{c<&Record::i>{} >= ref{i}})
+        .async(loop, [&](std::exception_ptr error, std::vector<Record> rows) {
+          CHECK(!error);
+          rows_a = std::move(rows);
+        });
+    b.getAll<Record>()(Where{c<&Record::i>{} < 2})
+        .async(loop, [&](std::exception_ptr error, std::vector<Record> rows) {
+          CHECK(!error);
+          rows_b = std::move(rows);
+        });
+    loop.run();
+    CHECK(rows_a.size() == 2);
+    REQUIRE(rows_b.size() == 1);
+    CHECK(rows_b[0].id == 1);
+  }
+
+  SECTION("Chained queries")
+  {
+    auto rows_after = std::vector<Record>{};
+    a.update<Record>()(Set{c<&Record::i>{} = 8})(Where{c<&Record::id>{} == 1})
+        .async(loop, [&](std::exception_ptr error) {
+          CHECK(!error);
+          a.getAll<Record>()(Where{c<&Record::i>{} == 8})
+              .async(loop,
+                     [&](std::exception_ptr, std::vector<Record> rows) {
+                       rows_after = std::move(rows);
+                     });
+        });
+    loop.run();
+    REQUIRE(rows_after.size() == 1);
+    CHECK(rows_after[0].id == 1);
+  }
+}
@@ -0,0 +1,143 @@
+#include <mysql_orm/BulkLoad.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+
+using mysql_orm::Connection;
+using mysql_orm::ConnectionOptions;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+
+namespace
+{
+struct Measure
+{
+  mysql_orm::id_t id;
+  double value;
+  float ratio;
+};
+}
+
+TEST_CASE("[BulkLoad] Field serialization", "[BulkLoad]")
+{
+  auto const serialize = [](auto const& value) {
+    auto out = std::string{};
+    mysql_orm::details::appendLoadDataField(out, value);
+    return out;
+  };
+
+  CHECK(serialize(42) == "42");
+  CHECK(serialize(-3) == "-3");
+  CHECK(serialize(std::string{"a\tb\nc\\d"}) == "a\\tb\\nc\\\\d");
+  CHECK(serialize(std::string{"\\N"}) == "\\\\N");
+  CHECK(serialize(std::optional<int>{}) == "\\N");
+  CHECK(serialize(std::optional<std::string>{"x"}) == "x");
+  CHECK(serialize(makeTm(2018, 1, 2, 3, 4, 5)) == "2018-01-02 03:04:05");
+  CHECK(serialize(1.5) == "1.5");
+  CHECK(serialize(0.1) == "0.10000000000000001");
+  CHECK(std::stod(serialize(0.1)) == 0.1);
+  CHECK(std::stof(serialize(0.1f)) == 0.1f);
+  CHECK(serialize(std::optional<double>{}) == "\\N");
+}
+
+TEST_CASE("[BulkLoad] Load buildquery", "[BulkLoad]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+
+  CHECK(table_records.loadDataCS<&Record::id, &Record::i, &Record::s>() ==
+        "LOAD DATA LOCAL INFILE 'mysql_orm' INTO TABLE `records` CHARACTER SET "
+        "utf8mb4 (`id`, `i`, `s`)");
+}
+
+TEST_CASE("[BulkLoad] Load", "[BulkLoad]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto table_optional_records =
+      make_table("optional_records",
+                 make_column<&RecordWithOptionals::id>("id"),
+                 make_column<&RecordWithOptionals::i>("i"),
+                 make_column<&RecordWithOptionals::s>("s"));
+  auto table_records_with_time =
+      make_table("records_with_time",
+                 make_column<&RecordWithTime::id>("id"),
+                 make_column<&RecordWithTime::time>("time"));
+  auto table_measures = make_table("measures",
+                                   make_column<&Measure::id>("id"),
+                                   make_column<&Measure::value>("value"),
+                                   make_column<&Measure::ratio>("ratio"));
+  auto options = ConnectionOptions{};
+  options.local_infile = true;
+  auto connection = Connection{
+      "localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db", options};
+  auto d = make_database(connection,
+                         table_records,
+                         table_optional_records,
+                         table_records_with_time,
+                         table_measures);
+
+  d.recreate();
+
+  SECTION("Escaped strings")
+  {
+    auto const records = std::vector<Record>{{1, 1, "one"},
+                                             {2, 2, "tab\there"},
+                                             {3, 4, "new\nline"},
+                                             {4, 8, "back\\slash"},
+                                             {5, 16, ""}};
+    CHECK(d.bulkLoad(records) == records.size());
+    CHECK(d.getAll<Record>()() == records);
+  }
+
+  SECTION("Many rows")
+  {
+    auto records = std::vector<Record>{};
+    for (auto i = 0u; i < 10000; ++i)
+      records.push_back(Record{i, static_cast<int>(i), std::to_string(i)});
+    CHECK(d.bulkLoad(records.begin(), records.end()) == records.size());
+    CHECK(d.getAll<Record>()() == records);
+  }
+
+  SECTION("Optionals")
+  {
+    auto const records =
+        std::vector<RecordWithOptionals>{{1, 1, "one"}, {2, {}, {}}};
+    CHECK(d.bulkLoad(records) == records.size());
+    auto const res = d.getAll<RecordWithOptionals>()();
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == records[0]);
+    CHECK(res[1] == records[1]);
+  }
+
+  SECTION("Datetime")
+  {
+    auto const records =
+        std::vector<RecordWithTime>{{1, makeTm(2018, 1, 2, 3, 4, 5)}};
+    CHECK(d.bulkLoad(records) == 1);
+    auto const res = d.getAll<RecordWithTime>()();
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == records[0]);
+  }
+
+  SECTION("Floating point")
+  {
+    auto const records =
+        std::vector<Measure>{{1, 0.1, 0.1f}, {2, -1e300, 3.4e38f}};
+    CHECK(d.bulkLoad(records) == records.size());
+    auto const res = d.getAll<Measure>()();
+    REQUIRE(res.size() == 2);
+    for (auto i = std::size_t{0}; i < res.size(); ++i)
+    {
+      CHECK(res[i].value == records[i].value);
+      CHECK(res[i].ratio == records[i].ratio);
+    }
+  }
+}
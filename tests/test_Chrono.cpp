@@ -0,0 +1,142 @@
+#include <mysql_orm/Chrono.hpp>
+
+#include <chrono>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/BindArray.hpp>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::getFieldSQLType;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::ref;
+using mysql_orm::sys_days;
+using mysql_orm::sys_seconds;
+using mysql_orm::sys_time;
+using mysql_orm::Where;
+using namespace std::chrono_literals;
+
+TEST_CASE("[Chrono] SQL types", "[Chrono]")
+{
+  CHECK(getFieldSQLType<sys_days>() == "DATE");
+  CHECK(getFieldSQLType<sys_seconds>() == "DATETIME");
+  CHECK(getFieldSQLType<sys_time<std::chrono::minutes>>() == "DATETIME");
+  CHECK(getFieldSQLType<sys_time<std::chrono::microseconds>>() ==
+        "DATETIME(6)");
+  CHECK(getFieldSQLType<std::chrono::seconds>() == "TIME");
+  CHECK(getFieldSQLType<std::chrono::milliseconds>() == "TIME(6)");
+  STATIC_REQUIRE(mysql_orm::details::is_date_v<sys_days>);
+  STATIC_REQUIRE_FALSE(mysql_orm::details::is_date_v<sys_seconds>);
+  STATIC_REQUIRE_FALSE(mysql_orm::details::is_date_v<std::chrono::hours>);
+  STATIC_REQUIRE_FALSE(mysql_orm::details::is_date_v<int>);
+}
+
+TEST_CASE("[Chrono] Conversions", "[Chrono]")
+{
+  using mysql_orm::details::fromMySQLTimeAs;
+  using mysql_orm::details::toMySQLTime;
+
+  SECTION("Time points")
+  {
+    auto const tp = sys_seconds{1234567890s};
+    auto const time = toMySQLTime(tp);
+    CHECK(time.year == 2009);
+    CHECK(time.month == 2);
+    CHECK(time.day == 13);
+    CHECK(time.hour == 23);
+    CHECK(time.minute == 31);
+    CHECK(time.second == 30);
+    CHECK(fromMySQLTimeAs<sys_seconds>(time) == tp);
+  }
+
+  SECTION("Before the epoch")
+  {
+    auto const tp = sys_time<std::chrono::microseconds>{-1us};
+    auto const time = toMySQLTime(tp);
+    CHECK(time.year == 1969);
+    CHECK(time.month == 12);
+    CHECK(time.day == 31);
+    CHECK(time.hour == 23);
+    CHECK(time.second_part == 999999);
+    CHECK(fromMySQLTimeAs<sys_time<std::chrono::microseconds>>(time) == tp);
+  }
+
+  SECTION("Dates")
+  {
+    auto const date = sys_days{mysql_orm::days{19000}};
+    CHECK(fromMySQLTimeAs<sys_days>(toMySQLTime(date)) == date);
+  }
+
+  SECTION("Durations")
+  {
+    auto const duration = -(30h + 5ms);
+    auto const time = toMySQLTime(duration);
+    CHECK(time.neg);
+    CHECK(time.day == 1);
+    CHECK(time.hour == 6);
+    CHECK(time.second_part == 5000);
+    CHECK(fromMySQLTimeAs<std::chrono::microseconds>(time) == duration);
+  }
+
+  SECTION("Long durations")
+  {
+    auto const duration = -(838h + 59min + 59s);
+    auto const time = toMySQLTime(duration);
+    CHECK(time.neg);
+    CHECK(time.day == 34);
+    CHECK(time.hour == 22);
+    CHECK(time.minute == 59);
+    CHECK(time.second == 59);
+    CHECK(fromMySQLTimeAs<std::chrono::seconds>(time) == duration);
+  }
+
+  SECTION("std::tm")
+  {
+    auto const time = toMySQLTime(sys_seconds{1234567890s});
+    auto const tm = mysql_orm::details::fromMySQLTime(time);
+    CHECK(tm.tm_wday == 5);
+    CHECK(tm.tm_yday == 43);
+  }
+}
+
+TEST_CASE("[Chrono] Insert and select", "[Chrono]")
+{
+  auto table_records =
+      make_table("records_with_chrono",
+                 make_column<&RecordWithChrono::id>("id"),
+                 make_column<&RecordWithChrono::date>("date"),
+                 make_column<&RecordWithChrono::time>("time"),
+                 make_column<&RecordWithChrono::precise_time>("precise_time"),
+                 make_column<&RecordWithChrono::duration>("duration"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  auto const record =
+      RecordWithChrono{1,
+                       sys_days{mysql_orm::days{17533}},
+                       sys_seconds{1514862245s},
+                       sys_time<std::chrono::microseconds>{1514862245123456us},
+                       -(838h + 59min + 59s)};
+  d.recreate();
+  d.insert(record)();
+
+  auto const res = d.getAll<RecordWithChrono>()();
+  REQUIRE(res.size() == 1);
+  CHECK(res[0] == record);
+
+  auto after = sys_seconds{1514862244s};
+  CHECK(d.getAll<RecordWithChrono>()(
+             Where{c<&RecordWithChrono::time>{} > ref{after}})()
+            .size() == 1);
+  after += 1s;
+  CHECK(d.getAll<RecordWithChrono>()(
+             Where{c<&RecordWithChrono::time>{} > ref{after}})()
+            .empty());
+}
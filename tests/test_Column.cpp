@@ -35,6 +35,12 @@ TEST_CASE("Create fields", "[Column]")
     }
   }
 
+  SECTION("Floating point")
+  {
+    CHECK(mysql_orm::getFieldSQLType<float>() == "FLOAT");
+    CHECK(mysql_orm::getFieldSQLType<double>() == "DOUBLE");
+  }
+
   SECTION("Optionals")
   {
     SECTION("String")
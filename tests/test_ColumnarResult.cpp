@@ -0,0 +1,201 @@
+#include <mysql_orm/ColumnarResult.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::ColumnarResult;
+using mysql_orm::Connection;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::NullableColumn;
+using mysql_orm::StringColumn;
+using mysql_orm::Where;
+
+namespace
+{
+struct Flag
+{
+  mysql_orm::id_t id;
+  bool enabled;
+  std::optional<bool> maybe;
+};
+}
+
+TEST_CASE("[ColumnarResult] Column storage", "[ColumnarResult]")
+{
+  using Columns =
+      ColumnarResult<&MixedRecord::id, &MixedRecord::i, &MixedRecord::s>::
+          columns_type;
+  STATIC_REQUIRE(std::is_same_v<std::tuple_element_t<0, Columns>,
+                                std::vector<mysql_orm::id_t>>);
+  STATIC_REQUIRE(
+      std::is_same_v<std::tuple_element_t<1, Columns>, std::vector<int>>);
+  STATIC_REQUIRE(std::is_same_v<std::tuple_element_t<2, Columns>,
+                                NullableColumn<StringColumn>>);
+  STATIC_REQUIRE(
+      std::is_same_v<ColumnarResult<&RecordWithOptionals::i>::columns_type,
+                     std::tuple<NullableColumn<std::vector<int>>>>);
+  using Flags = ColumnarResult<&Flag::enabled, &Flag::maybe>::columns_type;
+  STATIC_REQUIRE(
+      std::is_same_v<Flags,
+                     std::tuple<std::vector<std::uint8_t>,
+                                NullableColumn<std::vector<std::uint8_t>>>>);
+}
+
+TEST_CASE("[ColumnarResult] String column", "[ColumnarResult]")
+{
+  auto column = StringColumn{};
+  CHECK(column.empty());
+  column.push_back("one");
+  column.push_back("");
+  column.push_back("three");
+  REQUIRE(column.size() == 3);
+  CHECK(column[0] == "one");
+  CHECK(column[1] == "");
+  CHECK(column[2] == "three");
+  CHECK(column.getBytes() == "onethree");
+  CHECK(column.getOffsets() == std::vector<std::size_t>{0, 3, 3, 8});
+}
+
+TEST_CASE("[ColumnarResult] Validity bitmap", "[ColumnarResult]")
+{
+  auto column = NullableColumn<std::vector<int>>{};
+  for (auto i = 0; i < 70; ++i)
+  {
+    auto& values = column.extend(i % 3 != 0);
+    values.push_back(i);
+  }
+  REQUIRE(column.size() == 70);
+  CHECK(column.nullCount() == 24);
+  CHECK(column.getValidity().size() == 2);
+  CHECK_FALSE(column.isValid(0));
+  CHECK(column.isValid(1));
+  CHECK(column.isValid(68));
+  CHECK_FALSE(column.isValid(69));
+  CHECK(column.getValues()[68] == 68);
+}
+
+TEST_CASE("[ColumnarResult] Select columns", "[ColumnarResult]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto table_optional_records =
+      make_table("optional_records",
+                 make_column<&RecordWithOptionals::id>("id"),
+                 make_column<&RecordWithOptionals::i>("i"),
+                 make_column<&RecordWithOptionals::s>("s"));
+  auto table_flags = make_table("flags",
+                                make_column<&Flag::id>("id"),
+                                make_column<&Flag::enabled>("enabled"),
+                                make_column<&Flag::maybe>("maybe"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(
+      connection, table_records, table_optional_records, table_flags);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+  d.execute(
+      "INSERT INTO `optional_records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, NULL, NULL))");
+  d.execute(
+      "INSERT INTO `flags` (`id`, `enabled`, `maybe`) VALUES "
+      "(1, 1, 0),"
+      "(2, 0, NULL)");
+
+  SECTION("Some attributes")
+  {
+    auto const res = d.getAll<&Record::i, &Record::s>().columns();
+    REQUIRE(res.size() == 3);
+    CHECK(res.get<&Record::i>() == std::vector<int>{1, 2, 4});
+    auto const& s = res.get<&Record::s>();
+    REQUIRE(s.size() == 3);
+    CHECK(s[0] == "one");
+    CHECK(s[1] == "two");
+    CHECK(s[2] == "four");
+    CHECK(s.getBytes() == "onetwofour");
+  }
+
+  SECTION("All attributes")
+  {
+    auto const res = d.getAll<Record>().columns();
+    REQUIRE(res.size() == 3);
+    CHECK(res.get<&Record::id>() == std::vector<mysql_orm::id_t>{1, 2, 3});
+  }
+
+  SECTION("Where and Limit")
+  {
+    auto const res =
+        d.getAll<&Record::id>()(Where{c<&Record::i>{} > 1})(Limit<1>{})
+            .columns();
+    CHECK(res.get<&Record::id>() == std::vector<mysql_orm::id_t>{2});
+  }
+
+  SECTION("No rows")
+  {
+    auto const res =
+        d.getAll<&Record::s>()(Where{c<&Record::i>{} == 3}).columns();
+    CHECK(res.empty());
+    CHECK(res.get<&Record::s>().empty());
+  }
+
+  SECTION("Optionals")
+  {
+    auto const res =
+        d.getAll<&RecordWithOptionals::i, &RecordWithOptionals::s>().columns();
+    REQUIRE(res.size() == 2);
+    auto const& i = res.get<&RecordWithOptionals::i>();
+    CHECK(i.isValid(0));
+    CHECK_FALSE(i.isValid(1));
+    CHECK(i.nullCount() == 1);
+    CHECK(i.getValues()[0] == 1);
+    auto const& s = res.get<&RecordWithOptionals::s>();
+    CHECK(s.isValid(0));
+    CHECK_FALSE(s.isValid(1));
+    CHECK(s.getValues()[0] == "one");
+    CHECK(s.getValues()[1] == "");
+  }
+
+  SECTION("Booleans")
+  {
+    auto const res = d.getAll<&Flag::enabled, &Flag::maybe>().columns();
+    REQUIRE(res.size() == 2);
+    CHECK(res.get<&Flag::enabled>() == std::vector<std::uint8_t>{1, 0});
+    auto const& maybe = res.get<&Flag::maybe>();
+    CHECK(maybe.isValid(0));
+    CHECK_FALSE(maybe.isValid(1));
+    CHECK(maybe.getValues()[0] == 0);
+  }
+
+  SECTION("Long strings")
+  {
+    auto const long_string = std::string(1000, 'a');
+    d.execute("UPDATE `records` SET `s`='" + long_string + "' WHERE `id`=2");
+    auto const res = d.getAll<&Record::s>().columns();
+    REQUIRE(res.size() == 3);
+    CHECK(res.get<&Record::s>()[1] == long_string);
+    CHECK(res.get<&Record::s>()[2] == "four");
+  }
+
+  SECTION("Buffered")
+  {
+    using Result = ColumnarResult<&Record::i, &Record::s>;
+    auto stmt = d.getAll<&Record::i, &Record::s>().build();
+    auto const res = stmt.setBuffered().executeColumns<Result>();
+    REQUIRE(res.size() == 3);
+    CHECK(res.get<&Record::s>()[2] == "four");
+  }
+}
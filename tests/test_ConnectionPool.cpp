@@ -0,0 +1,95 @@
+#include <mysql_orm/ConnectionPool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+
+using mysql_orm::ConnectionPool;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::TimeoutException;
+
+TEST_CASE("[ConnectionPool] Lease", "[ConnectionPool]")
+{
+  auto pool = ConnectionPool{
+      "localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db", 1, 2};
+  REQUIRE(pool.capacity() == 2);
+
+  SECTION("Leases are returned")
+  {
+    auto* hdl = static_cast<MYSQL*>(nullptr);
+    {
+      auto lease = pool.lease();
+      hdl = lease.getHandle();
+      REQUIRE(hdl != nullptr);
+    }
+    auto lease = pool.lease();
+    CHECK(lease.getHandle() == hdl);
+  }
+
+  SECTION("Connections are opened up to the maximal size")
+  {
+    auto a = pool.lease();
+    auto b = pool.lease();
+    CHECK(a.getHandle() != b.getHandle());
+    CHECK(a.getStatementCache() != b.getStatementCache());
+    CHECK_THROWS_AS(pool.lease(std::chrono::milliseconds{10}),
+                    TimeoutException);
+  }
+
+  SECTION("Waiting for a lease")
+  {
+    auto a = pool.lease();
+    auto b = pool.lease();
+    auto t = std::thread{[b = std::move(b)]() mutable {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      auto released = std::move(b);
+    }};
+    auto c = pool.lease(std::chrono::seconds{5});
+    CHECK(c.getHandle() != a.getHandle());
+    t.join();
+  }
+}
+
+TEST_CASE("[ConnectionPool] Concurrent databases", "[ConnectionPool]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto pool = ConnectionPool{
+      "localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db", 0, 4};
+  {
+    auto lease = pool.lease();
+    auto d = make_database(lease, table_records);
+    d.recreate();
+    d.execute(
+        "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+        R"((1, 1, "one"),)"
+        R"((2, 2, "two"))");
+    CHECK(d.getStatementCache() == lease.getStatementCache());
+  }
+
+  auto failures = std::atomic<int>{0};
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < 16; ++i)
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < 20; ++j)
+      {
+        auto lease = pool.lease();
+        auto d = make_database(lease, table_records);
+        if (d.getAll<Record>()().size() != 2)
+          ++failures;
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+  CHECK(failures == 0);
+}
@@ -34,6 +34,31 @@ TEST_CASE("[GetAll] GetAll buildquery", "[GetAll]")
         "SELECT `id`, `i`, `foo` FROM `mixed_records`");
 }
 
+TEST_CASE("[GetAll] buildquery is rendered once per table names", "[GetAll]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto table_others = make_table("others",
+                                 make_column<&Record::id>("id"),
+                                 make_column<&Record::i>("i"),
+                                 make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d_records = make_database(connection, table_records);
+  auto d_others = make_database(connection, table_others);
+
+  auto const records_sql = d_records.getAll<Record>().buildquery();
+  auto const others_sql = d_others.getAll<Record>().buildquery();
+  CHECK(records_sql == "SELECT `id`, `i`, `s` FROM `records`");
+  CHECK(others_sql == "SELECT `id`, `i`, `s` FROM `others`");
+  // Tables of the same type share the text if they have the same names.
+  CHECK(d_records.getAll<Record>().buildquery().data() == records_sql.data());
+  auto d_copy = make_database(connection, table_records);
+  CHECK(d_copy.getAll<Record>().buildquery().data() == records_sql.data());
+}
+
 TEST_CASE("[GetAll] GetAll", "[GetAll]")
 {
   auto table_records = make_table("records",
@@ -132,3 +157,27 @@ TEST_CASE("[GetAll] GetAll with optionals", "[GetAll]")
     CHECK(res[0] == RecordWithTime{1, makeTm(2018, 1, 2, 3, 4, 5)});
   }
 }
+
+TEST_CASE("[GetAll] Strings only take the size of the data", "[GetAll]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, REPEAT("a", 1000)))");
+
+  auto const res = d.getAll<Record>()();
+  REQUIRE(res.size() == 2);
+  CHECK(res[0] == Record{1, 1, "one"});
+  CHECK(res[0].s.capacity() < 64);
+  CHECK(res[1].s == std::string(1000, 'a'));
+  CHECK(res[1].s.capacity() < 2048);
+}
@@ -0,0 +1,70 @@
+#include <mysql_orm/GetByIds.hpp>
+
+#include <string>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+
+using mysql_orm::Connection;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+
+TEST_CASE("[GetByIds] Get by ids", "[GetByIds]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  auto records = std::vector<Record>{};
+  for (auto i = 1u; i <= 200; ++i)
+    records.push_back(Record{i, static_cast<int>(i) * 2, std::to_string(i)});
+  d.insert(records.begin(), records.end());
+
+  auto& cache = *d.getStatementCache();
+  cache.clear();
+
+  SECTION("Input order")
+  {
+    auto const res = d.getByIds<&Record::id>(std::vector<mysql_orm::id_t>{
+        3, 1, 1000, 2});
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{3, 6, "3"});
+    CHECK(res[1] == Record{1, 2, "1"});
+    CHECK(res[2] == Record{2, 4, "2"});
+    // 4 keys are sent in a bucket of 8.
+    CHECK(cache.size() == 1);
+  }
+
+  SECTION("Map")
+  {
+    auto ids = std::vector<mysql_orm::id_t>{};
+    for (auto i = mysql_orm::id_t{1}; i <= 150; ++i)
+      ids.push_back(i);
+    auto const res = d.getMapByIds<&Record::id>(ids);
+    REQUIRE(res.size() == 150);
+    CHECK(res.at(150) == Record{150, 300, "150"});
+    // 150 keys are sent in buckets of 128 and 32.
+    CHECK(cache.size() == 2);
+  }
+
+  SECTION("Single id")
+  {
+    auto const res = d.getByIds<&Record::id>(std::vector<mysql_orm::id_t>{7});
+    REQUIRE(res.size() == 1);
+    CHECK(res[0].s == "7");
+  }
+
+  SECTION("No ids")
+  {
+    CHECK(d.getByIds<&Record::id>(std::vector<mysql_orm::id_t>{}).empty());
+  }
+}
@@ -0,0 +1,125 @@
+#include <mysql_orm/GroupBy.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Projection.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::Avg;
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Count;
+using mysql_orm::Desc;
+using mysql_orm::Field;
+using mysql_orm::GroupBy;
+using mysql_orm::Having;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::Max;
+using mysql_orm::OrderBy;
+using mysql_orm::Sum;
+using mysql_orm::Where;
+
+namespace
+{
+struct Totals
+{
+  std::string s;
+  std::optional<long long> total;
+  unsigned long long nb;
+};
+}
+
+TEST_CASE("[GroupBy] GroupBy buildquery", "[GroupBy]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  CHECK(d.select<Field<&Record::s>, Sum<&Record::i>>()(
+             GroupBy<&Record::s>{})
+            .buildquery() ==
+        "SELECT `s`, SUM(`i`) FROM `records` GROUP BY `s`");
+  CHECK(d.select<Field<&Record::s>, Count<>, Max<&Record::i>>()(
+             Where{c<&Record::id>{} > 1})(GroupBy<&Record::s, &Record::i>{})(
+             Having{Count<>{} > 1})(OrderBy<&Record::s, Desc>{})(Limit<2>{})
+            .buildquery() ==
+        "SELECT `s`, COUNT(*), MAX(`i`) FROM `records` WHERE `id`>? "
+        "GROUP BY `s`, `i` HAVING COUNT(*)>? ORDER BY `s` DESC LIMIT 2");
+}
+
+TEST_CASE("[GroupBy] Grouped aggregates", "[GroupBy]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "a"),)"
+      R"((2, 2, "b"),)"
+      R"((3, 4, "a"),)"
+      R"((4, 8, "c"),)"
+      R"((5, 16, "a"))");
+
+  SECTION("Into tuples")
+  {
+    auto const res =
+        d.select<Field<&Record::s>, Sum<&Record::i>, Avg<&Record::i>>()(
+            GroupBy<&Record::s>{})(OrderBy<&Record::s>{})();
+    static_assert(
+        std::is_same_v<
+            std::remove_cv_t<decltype(res)>,
+            std::vector<std::tuple<std::string,
+                                   std::optional<long long>,
+                                   std::optional<double>>>>);
+    REQUIRE(res.size() == 3);
+    CHECK(std::get<0>(res[0]) == "a");
+    CHECK(std::get<1>(res[0]) == 21);
+    CHECK(std::get<2>(res[0]) == Catch::Approx(7.0));
+    CHECK(std::get<0>(res[2]) == "c");
+    CHECK(std::get<1>(res[2]) == 8);
+  }
+
+  SECTION("Into structs")
+  {
+    auto const res = d.select<Field<&Record::s, &Totals::s>,
+                              Sum<&Record::i, &Totals::total>,
+                              Count<&Totals::nb>>()(GroupBy<&Record::s>{})(
+        Having{Count<>{} > 1})();
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(res)>,
+                                 std::vector<Totals>>);
+    REQUIRE(res.size() == 1);
+    CHECK(res[0].s == "a");
+    CHECK(res[0].total == 21);
+    CHECK(res[0].nb == 3);
+  }
+
+  SECTION("With where")
+  {
+    auto const res = d.select<Field<&Record::s>, Count<>>()(
+        Where{c<&Record::i>{} > 1})(GroupBy<&Record::s>{})(
+        Having{Sum<&Record::i>{} >= 8})(OrderBy<&Record::s>{})();
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == std::tuple<std::string, unsigned long long>{"a", 2});
+    CHECK(res[1] == std::tuple<std::string, unsigned long long>{"c", 1});
+  }
+}
@@ -6,6 +6,7 @@
 #include <mysql_orm/Database.hpp>
 
 using mysql_orm::Autoincrement;
+using mysql_orm::BatchSize;
 using mysql_orm::c;
 using mysql_orm::Connection;
 using mysql_orm::Limit;
@@ -106,3 +107,110 @@ TEST_CASE("[Insert] insertAllBut buildquery", "[Insert]")
   CHECK(d.insertAllBut<&Record::i, &Record::s>(r).buildquery() ==
         "INSERT INTO `records` (`id`) VALUES (?)");
 }
+
+TEST_CASE("[Insert] Insert batch buildquery", "[Insert]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+
+  CHECK(table_records.insertBatchCS<1, &Record::i, &Record::s>() ==
+        "INSERT INTO `records` (`i`, `s`) VALUES (?, ?)");
+  CHECK(table_records.insertBatchCS<3, &Record::i, &Record::s>() ==
+        "INSERT INTO `records` (`i`, `s`) VALUES (?, ?), (?, ?), (?, ?)");
+}
+
+TEST_CASE("[Insert] Time slots", "[Insert]")
+{
+  auto table_chrono =
+      make_table("records_with_chrono",
+                 make_column<&RecordWithChrono::id>("id"),
+                 make_column<&RecordWithChrono::date>("date"),
+                 make_column<&RecordWithChrono::duration>("duration"));
+  using Table = decltype(table_chrono);
+
+  STATIC_REQUIRE(
+      mysql_orm::Insert<Table, &RecordWithChrono::id>::getNbInputTimeSlots() ==
+      0);
+  STATIC_REQUIRE(mysql_orm::InsertBatch<Table,
+                                        8,
+                                        &RecordWithChrono::id,
+                                        &RecordWithChrono::date,
+                                        &RecordWithChrono::duration>::
+                     getNbInputTimeSlots() == 16);
+}
+
+TEST_CASE("[Insert] Insert range", "[Insert]")
+{
+  auto table_records =
+      make_table("records",
+                 make_column<&Record::id>("id", Autoincrement{}, PrimaryKey{}),
+                 make_column<&Record::i>("i"),
+                 make_column<&Record::s>("s"));
+  auto table_records_with_time = make_table(
+      "records_with_time",
+      make_column<&RecordWithTime::id>("id", Autoincrement{}, PrimaryKey{}),
+      make_column<&RecordWithTime::time>("time"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records, table_records_with_time);
+
+  d.recreate();
+  auto const records = std::vector<Record>{{1, 1, "one"},
+                                           {2, 2, "two"},
+                                           {3, 4, "four"},
+                                           {4, 8, "eight"},
+                                           {5, 16, "sixteen"}};
+
+  SECTION("Default batch size")
+  {
+    d.insert(records.begin(), records.end());
+    CHECK(d.getAll<Record>()() == records);
+  }
+
+  SECTION("Full and partial batches")
+  {
+    d.insert(records.begin(), records.end(), BatchSize<2>{});
+    CHECK(d.getAll<Record>()() == records);
+  }
+
+  SECTION("Empty range")
+  {
+    d.insertMany(std::vector<Record>{});
+    CHECK(d.getAll<Record>()().empty());
+  }
+
+  SECTION("insertMany")
+  {
+    d.insertMany(records, BatchSize<4>{});
+    CHECK(d.getAll<Record>()() == records);
+  }
+
+  SECTION("insertAllBut")
+  {
+    auto const without_ids =
+        std::vector<Record>{{0, 1, "one"}, {0, 2, "two"}, {0, 4, "four"}};
+    d.insertAllBut<&Record::id>(
+        without_ids.begin(), without_ids.end(), BatchSize<2>{});
+    auto const res = d.getAll<Record>()();
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{1, 1, "one"});
+    CHECK(res[1] == Record{2, 2, "two"});
+    CHECK(res[2] == Record{3, 4, "four"});
+  }
+
+  SECTION("Datetime")
+  {
+    auto const times =
+        std::vector<RecordWithTime>{{1, makeTm(2018, 1, 2, 3, 4, 5)},
+                                    {2, makeTm(2018, 2, 3, 4, 5, 6)},
+                                    {3, makeTm(2018, 3, 4, 5, 6, 7)}};
+    d.insertMany(times, BatchSize<2>{});
+    auto const res = d.getAll<RecordWithTime>()();
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == times[0]);
+    CHECK(res[1] == times[1]);
+    CHECK(res[2] == times[2]);
+  }
+}
@@ -0,0 +1,116 @@
+#include <mysql_orm/Join.hpp>
+
+#include <string>
+#include <utility>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Desc;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::On;
+using mysql_orm::OrderBy;
+using mysql_orm::Where;
+
+namespace
+{
+struct Tag
+{
+  mysql_orm::id_t id;
+  mysql_orm::id_t record_id;
+  std::string name;
+
+  bool operator==(Tag const& b) const noexcept
+  {
+    return this->id == b.id && this->record_id == b.record_id &&
+           this->name == b.name;
+  }
+};
+
+auto makeTables()
+{
+  return std::make_pair(make_table("records",
+                                   make_column<&Record::id>("id"),
+                                   make_column<&Record::i>("i"),
+                                   make_column<&Record::s>("s")),
+                        make_table("tags",
+                                   make_column<&Tag::id>("id"),
+                                   make_column<&Tag::record_id>("record_id"),
+                                   make_column<&Tag::name>("name")));
+}
+}
+
+TEST_CASE("[Join] Join buildquery", "[Join]")
+{
+  auto [table_records, table_tags] = makeTables();
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records, table_tags);
+
+  CHECK(d.join<Record, Tag>(On{c<&Record::id>{} == c<&Tag::record_id>{}})
+            .buildquery() ==
+        "SELECT `records`.`id`, `records`.`i`, `records`.`s`, `tags`.`id`, "
+        "`tags`.`record_id`, `tags`.`name` FROM `records` INNER JOIN `tags` "
+        "ON `records`.`id`=`tags`.`record_id`");
+  CHECK(d.join<Record, Tag>(On{c<&Record::id>{} == c<&Tag::record_id>{}})(
+             Where{c<&Record::i>{} > 1})(OrderBy<&Tag::id, Desc>{})(
+             Limit<2>{})
+            .buildquery() ==
+        "SELECT `records`.`id`, `records`.`i`, `records`.`s`, `tags`.`id`, "
+        "`tags`.`record_id`, `tags`.`name` FROM `records` INNER JOIN `tags` "
+        "ON `records`.`id`=`tags`.`record_id` WHERE `records`.`i`>? "
+        "ORDER BY `tags`.`id` DESC LIMIT 2");
+}
+
+TEST_CASE("[Join] Joined rows", "[Join]")
+{
+  auto [table_records, table_tags] = makeTables();
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records, table_tags);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 4, "one"),)"
+      R"((2, 1, "two"),)"
+      R"((3, 8, "three"))");
+  d.execute(
+      "INSERT INTO `tags` (`id`, `record_id`, `name`) VALUES "
+      R"((1, 1, "a"),)"
+      R"((2, 3, "b"),)"
+      R"((3, 1, "c"))");
+
+  auto const rows =
+      d.join<Record, Tag>(On{c<&Record::id>{} == c<&Tag::record_id>{}})(
+          OrderBy<&Tag::id>{})();
+  REQUIRE(rows.size() == 3);
+  CHECK(rows[0] == std::make_pair(Record{1, 4, "one"}, Tag{1, 1, "a"}));
+  CHECK(rows[1] == std::make_pair(Record{3, 8, "three"}, Tag{2, 3, "b"}));
+  CHECK(rows[2] == std::make_pair(Record{1, 4, "one"}, Tag{3, 1, "c"}));
+
+  auto const filtered =
+      d.join<Record, Tag>(On{c<&Record::id>{} == c<&Tag::record_id>{}})(
+          Where{c<&Tag::name>{} == "b"})();
+  REQUIRE(filtered.size() == 1);
+  CHECK(filtered[0].first == Record{3, 8, "three"});
+  CHECK(filtered[0].second == Tag{2, 3, "b"});
+
+  auto count = 0;
+  for (auto const& [record, tag] :
+       d.join<Record, Tag>(On{c<&Record::id>{} == c<&Tag::record_id>{}})
+           .stream())
+  {
+    CHECK(record.id == tag.record_id);
+    ++count;
+  }
+  CHECK(count == 3);
+}
@@ -5,12 +5,15 @@
 #include <Record.hh>
 #include <mysql_orm/Database.hpp>
 #include <mysql_orm/GetAll.hpp>
+#include <mysql_orm/Where.hpp>
 
 using mysql_orm::c;
 using mysql_orm::Connection;
 using mysql_orm::Limit;
 using mysql_orm::make_column;
+using mysql_orm::Offset;
 using mysql_orm::ref;
+using mysql_orm::Where;
 
 TEST_CASE("[Limit] Limit buildquery", "[Limit]")
 {
@@ -24,6 +27,17 @@ TEST_CASE("[Limit] Limit buildquery", "[Limit]")
 
   CHECK(d.getAll<Record>()(Limit<2>{}).buildquery() ==
         "SELECT `id`, `i`, `s` FROM `records` LIMIT 2");
+  CHECK(d.getAll<Record>()(Limit<>{2}).buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` LIMIT ?");
+  CHECK(d.getAll<Record>()(Limit<2>{})(Offset<3>{}).buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` LIMIT 2 OFFSET 3");
+  CHECK(d.getAll<Record>()(Limit<>{2})(Offset<>{3}).buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` LIMIT ? OFFSET ?");
+  CHECK(d.getAll<Record>()(Where{c<&Record::i>{} == 1})(Limit<>{2})(
+             Offset<>{3})
+            .buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` WHERE `i`=? "
+        "LIMIT ? OFFSET ?");
 }
 
 TEST_CASE("[Limit] Simple Limit", "[Limit]")
@@ -83,3 +97,44 @@ TEST_CASE("[Limit] Simple Limit", "[Limit]")
     }
   }
 }
+
+TEST_CASE("[Limit] Offset", "[Limit]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"),)"
+      R"((4, 8, "eight"))");
+
+  SECTION("Templated")
+  {
+    auto const res = d.getAll<Record>()(Limit<2>{})(Offset<1>{})();
+    REQUIRE(res.size() == 2);
+    CHECK(res[0].id == 2);
+    CHECK(res[1].id == 3);
+  }
+
+  SECTION("Pages share a statement")
+  {
+    auto& cache = *d.getStatementCache();
+    cache.clear();
+    for (auto page = size_t{0}; page < 2; ++page)
+    {
+      auto const res = d.getAll<Record>()(Where{c<&Record::i>{} > 1})(
+          Limit<>{2})(Offset<>{page * 2})();
+      REQUIRE(res.size() == (page == 0 ? 2 : 1));
+      CHECK(res[0].id == 2 + page * 2);
+    }
+    CHECK(cache.size() == 1);
+  }
+}
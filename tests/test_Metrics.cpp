@@ -0,0 +1,127 @@
+#include <mysql_orm/Metrics.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Histogram;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::MetricsRegistry;
+using mysql_orm::Phase;
+using mysql_orm::PrimaryKey;
+using mysql_orm::Where;
+
+TEST_CASE("[Metrics] Histogram buckets", "[Metrics]")
+{
+  for (auto v : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull,
+                 123456789ull, ~0ull})
+  {
+    auto const bucket = Histogram::bucketOf(v);
+    REQUIRE(bucket < Histogram::nb_buckets);
+    CHECK(Histogram::bucketUpperBound(bucket) >= v);
+    if (bucket > 0)
+      CHECK(Histogram::bucketUpperBound(bucket - 1) < v);
+    // The bucket spans less than 12.5% of its values.
+    CHECK(Histogram::bucketUpperBound(bucket) - v <= v / 8);
+  }
+  static_assert(Histogram::bucketOf(7) == 7);
+  static_assert(Histogram::bucketOf(8) == 8);
+  static_assert(Histogram::bucketOf(16) == 16);
+  static_assert(Histogram::bucketOf(18) == 17);
+}
+
+TEST_CASE("[Metrics] Histogram percentiles", "[Metrics]")
+{
+  auto h = Histogram{};
+  CHECK(h.snapshot().percentile(0.5) == 0);
+  for (auto v = 1ull; v <= 1000; ++v)
+    h.record(v);
+  auto const snap = h.snapshot();
+  CHECK(snap.count == 1000);
+  CHECK(snap.sum == 500500);
+  CHECK(snap.max == 1000);
+  CHECK(snap.percentile(0.5) >= 500);
+  CHECK(snap.percentile(0.5) <= 500 + 500 / 8);
+  CHECK(snap.percentile(0.99) >= 990);
+  CHECK(snap.percentile(1) == 1000);
+}
+
+TEST_CASE("[Metrics] Snapshot merges threads", "[Metrics]")
+{
+  auto registry = MetricsRegistry{};
+  auto const shape = mysql_orm::fnv1a("SELECT 1");
+  static_assert(mysql_orm::fnv1a("") == 0xcbf29ce484222325);
+
+  auto record = [&registry, shape](std::uint64_t value) {
+    auto& metrics = registry.getShapeMetrics(shape, "SELECT 1");
+    metrics.phases[static_cast<std::size_t>(Phase::Execute)].record(value);
+    metrics.rows.fetch_add(2);
+    metrics.bytes.fetch_add(10);
+  };
+  auto threads = std::vector<std::thread>{};
+  for (auto i = 0; i < 4; ++i)
+    threads.emplace_back(record, 100 * (i + 1));
+  for (auto& thread : threads)
+    thread.join();
+  record(1);
+
+  auto const snapshot = registry.snapshot();
+  REQUIRE(snapshot.size() == 1);
+  CHECK(snapshot[0].shape == shape);
+  CHECK(snapshot[0].sql == "SELECT 1");
+  CHECK(snapshot[0].rows == 10);
+  CHECK(snapshot[0].bytes == 50);
+  CHECK(snapshot[0][Phase::Execute].count == 5);
+  CHECK(snapshot[0][Phase::Execute].sum == 1001);
+  CHECK(snapshot[0][Phase::Execute].max == 400);
+  CHECK(snapshot[0][Phase::Prepare].count == 0);
+}
+
+TEST_CASE("[Metrics] Record queries", "[Metrics]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id", PrimaryKey{}),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+  auto registry = MetricsRegistry{};
+
+  d.recreate();
+  d.insert(Record{0, 1, "one"});
+  d.insert(Record{0, 2, "two"});
+  d.setMetrics(&registry);
+
+  for (auto i = 0; i < 3; ++i)
+    CHECK(d.getAll<Record>()(Where{c<&Record::i>{} > 0})().size() == 2);
+
+  auto const snapshot = registry.snapshot();
+  REQUIRE(snapshot.size() == 1);
+  auto const& shape = snapshot[0];
+  CHECK(shape.shape == mysql_orm::fnv1a(shape.sql));
+  CHECK(shape.rows == 6);
+  // The integers of both rows, and "one" and "two".
+  auto const int_bytes = sizeof(Record::id) + sizeof(Record::i);
+  CHECK(shape.bytes == 3 * (2 * int_bytes + 3 + 3));
+  // The statement is prepared once, then taken from the cache.
+  CHECK(shape[Phase::Prepare].count == 1);
+  CHECK(shape[Phase::Bind].count == 3);
+  CHECK(shape[Phase::Execute].count == 3);
+  // The last fetch of each execution returns no row.
+  CHECK(shape[Phase::Fetch].count == 9);
+  CHECK(shape[Phase::Decode].count == 6);
+
+  d.setMetrics(nullptr);
+  d.getAll<Record>()();
+  CHECK(registry.snapshot().size() == 1);
+}
@@ -0,0 +1,101 @@
+#include <mysql_orm/OrderBy.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/GetAll.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::Asc;
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Desc;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::OrderBy;
+using mysql_orm::Where;
+
+TEST_CASE("[OrderBy] OrderBy buildquery", "[OrderBy]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  CHECK(d.getAll<Record>()(OrderBy<&Record::i>{}).buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` ORDER BY `i` ASC");
+  CHECK(d.getAll<Record>()(OrderBy<&Record::i, Desc>{})(Limit<2>{})
+            .buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` ORDER BY `i` DESC LIMIT 2");
+  CHECK(d.getAll<Record>()(Where{c<&Record::i>{} > 1})(
+             OrderBy<&Record::s, Asc>{})
+            .buildquery() ==
+        "SELECT `id`, `i`, `s` FROM `records` WHERE `i`>? ORDER BY `s` ASC");
+}
+
+TEST_CASE("[OrderBy] Ordered results", "[OrderBy]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 4, "one"),)"
+      R"((2, 1, "two"),)"
+      R"((3, 8, "three"),)"
+      R"((4, 2, "four"),)"
+      R"((5, 16, "five"))");
+
+  SECTION("OrderBy")
+  {
+    auto const res =
+        d.getAll<Record>()(Where{c<&Record::i>{} > 1})(
+            OrderBy<&Record::i, Desc>{})(Limit<>{3})();
+    REQUIRE(res.size() == 3);
+    CHECK(res[0].id == 5);
+    CHECK(res[1].id == 3);
+    CHECK(res[2].id == 1);
+  }
+
+  SECTION("Paginate")
+  {
+    auto& cache = *d.getStatementCache();
+    cache.clear();
+    auto ids = std::vector<unsigned int>{};
+    auto nb_pages = 0;
+    for (auto const& page : d.paginate<&Record::id>(2))
+    {
+      ++nb_pages;
+      CHECK(page.size() <= 2);
+      for (auto const& record : page)
+        ids.push_back(record.id);
+    }
+    CHECK(nb_pages == 3);
+    CHECK(ids == std::vector<unsigned int>{1, 2, 3, 4, 5});
+    // One statement for the first page, one for the others.
+    CHECK(cache.size() == 2);
+  }
+
+  SECTION("Paginate with full last page")
+  {
+    auto nb_pages = 0;
+    for (auto const& page : d.paginate<&Record::id>(5))
+    {
+      ++nb_pages;
+      CHECK(page.size() == 5);
+    }
+    CHECK(nb_pages == 1);
+  }
+}
@@ -0,0 +1,124 @@
+#include <mysql_orm/QueryAuditor.hpp>
+
+#include <string>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::AuditMode;
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::OrderBy;
+using mysql_orm::PrimaryKey;
+using mysql_orm::QueryAuditor;
+using mysql_orm::QueryPlan;
+using mysql_orm::QueryPlanException;
+using mysql_orm::Where;
+
+TEST_CASE("[QueryAuditor] Parse plan", "[QueryAuditor]")
+{
+  auto const json = R"({
+  "query_block": {
+    "select_id": 1,
+    "ordering_operation": {
+      "using_filesort": true,
+      "nested_loop": [
+        {
+          "table": {
+            "table_name": "records",
+            "access_type": "ALL",
+            "rows_examined_per_scan": 1200,
+            "filtered": "100.00"
+          }
+        },
+        {
+          "table": {
+            "table_name": "tags",
+            "access_type": "ref",
+            "key": "record_id",
+            "rows_examined_per_scan": 2
+          }
+        }
+      ]
+    }
+  }
+})";
+  auto const plan = mysql_orm::details::parseQueryPlan("SELECT", json);
+  REQUIRE(plan.tables.size() == 2);
+  CHECK(plan.tables[0].table_name == "records");
+  CHECK(plan.tables[0].access_type == "ALL");
+  CHECK(plan.tables[0].key.empty());
+  CHECK(plan.tables[0].rows == 1200);
+  CHECK(plan.tables[1].table_name == "tags");
+  CHECK(plan.tables[1].access_type == "ref");
+  CHECK(plan.tables[1].key == "record_id");
+  CHECK(plan.tables[1].rows == 2);
+  CHECK(plan.using_filesort);
+}
+
+TEST_CASE("[QueryAuditor] Audit queries", "[QueryAuditor]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id", PrimaryKey{}),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+  d.getStatementCache()->clear();
+
+  auto reports = std::vector<QueryPlan>{};
+  auto const report = [&](QueryPlan const& plan) { reports.push_back(plan); };
+
+  SECTION("Sampled")
+  {
+    auto auditor = QueryAuditor{report, AuditMode::Sampled, 0};
+    d.setAuditor(&auditor);
+    CHECK(d.getAll<Record>()(Where{c<&Record::i>{} == 2})().size() == 1);
+    REQUIRE(reports.size() == 1);
+    CHECK(reports[0].full_scans == std::vector<std::string>{"records"});
+    // Queries are only audited once.
+    d.getStatementCache()->clear();
+    d.getAll<Record>()(Where{c<&Record::i>{} == 4})();
+    CHECK(reports.size() == 1);
+    // Lookups by primary key are fine.
+    d.getAll<Record>()(Where{c<&Record::id>{} == 1})();
+    CHECK(reports.size() == 1);
+    d.setAuditor(nullptr);
+  }
+
+  SECTION("Strict")
+  {
+    auto auditor = QueryAuditor{report, AuditMode::Strict, 0};
+    d.setAuditor(&auditor);
+    CHECK_THROWS_AS(d.getAll<Record>()(OrderBy<&Record::i>{})(),
+                    QueryPlanException);
+    REQUIRE(reports.size() == 1);
+    CHECK(reports[0].using_filesort);
+    CHECK_NOTHROW(d.getAll<Record>()(Where{c<&Record::id>{} == 1})());
+    d.setAuditor(nullptr);
+  }
+
+  SECTION("Threshold")
+  {
+    auto auditor = QueryAuditor{report, AuditMode::Strict, 1000};
+    d.setAuditor(&auditor);
+    CHECK_NOTHROW(d.getAll<Record>()(Where{c<&Record::i>{} == 2})());
+    CHECK(reports.empty());
+    d.setAuditor(nullptr);
+  }
+}
@@ -0,0 +1,148 @@
+#include <mysql_orm/Relation.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch_amalgamated.hpp>
+
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::HasMany;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::Where;
+
+namespace
+{
+struct Line
+{
+  mysql_orm::id_t id;
+  mysql_orm::id_t order_id;
+  std::string item;
+};
+
+struct Comment
+{
+  mysql_orm::id_t id;
+  std::optional<mysql_orm::id_t> order_id;
+  std::string text;
+};
+
+struct Order
+{
+  mysql_orm::id_t id;
+  std::string customer;
+  std::vector<Line> lines;
+  std::vector<Comment> comments;
+};
+
+using OrderLines = HasMany<&Order::id, &Line::order_id, &Order::lines>;
+using OrderComments =
+    HasMany<&Order::id, &Comment::order_id, &Order::comments>;
+}
+
+TEST_CASE("[Relation] Eager loading", "[Relation]")
+{
+  auto table_orders = make_table("orders",
+                                 make_column<&Order::id>("id"),
+                                 make_column<&Order::customer>("customer"));
+  auto table_lines = make_table("lines",
+                                make_column<&Line::id>("id"),
+                                make_column<&Line::order_id>("order_id"),
+                                make_column<&Line::item>("item"));
+  auto table_comments =
+      make_table("comments",
+                 make_column<&Comment::id>("id"),
+                 make_column<&Comment::order_id>("order_id"),
+                 make_column<&Comment::text>("text"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d =
+      make_database(connection, table_orders, table_lines, table_comments);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `orders` (`id`, `customer`) VALUES "
+      R"((1, "alice"),)"
+      R"((2, "bob"),)"
+      R"((3, "carol"))");
+  d.execute(
+      "INSERT INTO `lines` (`id`, `order_id`, `item`) VALUES "
+      R"((1, 1, "apple"),)"
+      R"((2, 3, "pear"),)"
+      R"((3, 1, "plum"))");
+  d.execute(
+      "INSERT INTO `comments` (`id`, `order_id`, `text`) VALUES "
+      R"((1, 1, "fast"),)"
+      R"((2, NULL, "spam"),)"
+      R"((3, 3, "late"))");
+
+  auto& cache = *d.getStatementCache();
+  cache.clear();
+
+  SECTION("Eager")
+  {
+    auto const orders = d.eager<OrderLines>(d.getAll<Order>());
+    REQUIRE(orders.size() == 3);
+    for (auto const& order : orders)
+    {
+      for (auto const& line : order.lines)
+        CHECK(line.order_id == order.id);
+      auto const expected = order.id == 1 ? 2u : order.id == 3 ? 1u : 0u;
+      CHECK(order.lines.size() == expected);
+    }
+    // One query for the orders, one for the lines.
+    CHECK(cache.size() == 2);
+  }
+
+  SECTION("Load")
+  {
+    auto orders =
+        d.getAll<Order>()(Where{c<&Order::customer>{} == "carol"})();
+    REQUIRE(orders.size() == 1);
+    d.load<OrderLines>(orders);
+    REQUIRE(orders[0].lines.size() == 1);
+    CHECK(orders[0].lines[0].item == "pear");
+  }
+
+  SECTION("Parents sharing a key")
+  {
+    auto orders = d.getAll<Order>()(Where{c<&Order::id>{} == 1})();
+    REQUIRE(orders.size() == 1);
+    orders.push_back(orders[0]);
+    d.load<OrderLines>(orders);
+    for (auto const& order : orders)
+    {
+      REQUIRE(order.lines.size() == 2);
+      CHECK(order.lines[0].item != order.lines[1].item);
+      for (auto const& line : order.lines)
+        CHECK((line.item == "apple" || line.item == "plum"));
+    }
+  }
+
+  SECTION("Nullable foreign key")
+  {
+    auto orders = d.getAll<Order>()();
+    REQUIRE(orders.size() == 3);
+    d.load<OrderComments>(orders);
+    for (auto const& order : orders)
+    {
+      auto const expected = order.id == 2 ? 0u : 1u;
+      REQUIRE(order.comments.size() == expected);
+      for (auto const& comment : order.comments)
+        CHECK(comment.order_id == order.id);
+    }
+  }
+
+  SECTION("No parents")
+  {
+    auto orders = std::vector<Order>{};
+    d.load<OrderLines>(orders);
+    CHECK(cache.size() == 0);
+  }
+}
@@ -0,0 +1,111 @@
+#include <mysql_orm/RowStream.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::ref;
+using mysql_orm::Where;
+
+TEST_CASE("[RowStream] Stream rows", "[RowStream]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto table_optional_records =
+      make_table("optional_records",
+                 make_column<&RecordWithOptionals::id>("id"),
+                 make_column<&RecordWithOptionals::i>("i"),
+                 make_column<&RecordWithOptionals::s>("s"));
+  auto table_records_with_time =
+      make_table("records_with_time",
+                 make_column<&RecordWithTime::id>("id"),
+                 make_column<&RecordWithTime::time>("time"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection,
+                         table_records,
+                         table_optional_records,
+                         table_records_with_time);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+  d.execute(
+      "INSERT INTO `optional_records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, NULL, NULL))");
+  d.execute(
+      "INSERT INTO `records_with_time` (`id`, `time`) VALUES (1, '2018-01-02 "
+      "03:04:05')");
+
+  SECTION("All rows")
+  {
+    auto res = std::vector<Record>{};
+    for (auto const& record : d.getAll<Record>().stream())
+      res.push_back(record);
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{1, 1, "one"});
+    CHECK(res[1] == Record{2, 2, "two"});
+    CHECK(res[2] == Record{3, 4, "four"});
+  }
+
+  SECTION("Where and Limit")
+  {
+    auto i = 1;
+    auto res = std::vector<Record>{};
+    for (auto const& record :
+         d.getAll<Record>()(Where{c<&Record::i>{} > ref{i}})(Limit<1>{})
+             .stream())
+      res.push_back(record);
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == Record{2, 2, "two"});
+  }
+
+  SECTION("No rows")
+  {
+    auto stream = d.getAll<Record>()(Where{c<&Record::i>{} == 3}).stream();
+    CHECK(stream.begin() == stream.end());
+  }
+
+  SECTION("Restart")
+  {
+    auto stream = d.getAll<Record>().stream();
+    CHECK(stream.begin()->id == 1);
+    auto n = 0;
+    for (auto it = stream.begin(); it != stream.end(); ++it)
+      ++n;
+    CHECK(n == 3);
+  }
+
+  SECTION("Optionals")
+  {
+    auto res = std::vector<RecordWithOptionals>{};
+    for (auto const& record : d.getAll<RecordWithOptionals>().stream())
+      res.push_back(record);
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == RecordWithOptionals{1, 1, "one"});
+    CHECK(res[1] == RecordWithOptionals{2, std::nullopt, std::nullopt});
+  }
+
+  SECTION("With time")
+  {
+    auto res = std::vector<RecordWithTime>{};
+    for (auto const& record : d.getAll<RecordWithTime>().stream())
+      res.push_back(record);
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == RecordWithTime{1, makeTm(2018, 1, 2, 3, 4, 5)});
+  }
+}
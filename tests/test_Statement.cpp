@@ -0,0 +1,233 @@
+#include <mysql_orm/Statement.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::make_varchar;
+using mysql_orm::ref;
+using mysql_orm::Where;
+
+TEST_CASE("[Statement] Buffered", "[Statement]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute("ALTER TABLE `records` MODIFY `s` MEDIUMTEXT");
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, REPEAT("a", 100000)),)"
+      R"((3, 4, ""))");
+
+  SECTION("Values longer than the default buffer")
+  {
+    auto stmt = d.getAll<Record>().build();
+    CHECK(stmt.setBuffered().isBuffered());
+    auto const res = stmt.execute();
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{1, 1, "one"});
+    CHECK(res[1] == Record{2, 2, std::string(100000, 'a')});
+    CHECK(res[2] == Record{3, 4, ""});
+  }
+
+  SECTION("Re-execution")
+  {
+    auto stmt = d.getAll<Record>()(Where{c<&Record::i>{} <= 2}).build();
+    stmt.setBuffered();
+    CHECK(stmt.execute().size() == 2);
+    d.execute("DELETE FROM `records` WHERE `id`=2");
+    auto const res = stmt.execute();
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == Record{1, 1, "one"});
+  }
+
+  SECTION("Only empty values")
+  {
+    auto const res = d.getAll<Record>()(Where{c<&Record::id>{} == 3})
+                         .build()
+                         .setBuffered()
+                         .execute();
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == Record{3, 4, ""});
+  }
+}
+
+TEST_CASE("[Statement] Truncated values", "[Statement]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto table_optional_records =
+      make_table("optional_records",
+                 make_column<&RecordWithOptionals::id>("id"),
+                 make_column<&RecordWithOptionals::i>("i"),
+                 make_column<&RecordWithOptionals::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records, table_optional_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, REPEAT("a", 300)),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, REPEAT("b", 60000)))");
+  d.execute(
+      "INSERT INTO `optional_records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, REPEAT("a", 1000)),)"
+      R"((2, 2, NULL))");
+
+  SECTION("Vector")
+  {
+    auto const res = d.getAll<Record>()();
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{1, 1, std::string(300, 'a')});
+    CHECK(res[1] == Record{2, 2, "two"});
+    CHECK(res[2] == Record{3, 4, std::string(60000, 'b')});
+  }
+
+  SECTION("Stream")
+  {
+    auto res = std::vector<Record>{};
+    for (auto const& record : d.getAll<Record>().stream())
+      res.push_back(record);
+    REQUIRE(res.size() == 3);
+    CHECK(res[0] == Record{1, 1, std::string(300, 'a')});
+    CHECK(res[1] == Record{2, 2, "two"});
+    CHECK(res[2] == Record{3, 4, std::string(60000, 'b')});
+  }
+
+  SECTION("Optionals")
+  {
+    auto const res = d.getAll<RecordWithOptionals>()();
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == RecordWithOptionals{1, 1, std::string(1000, 'a')});
+    CHECK(res[1] == RecordWithOptionals{2, 2, std::nullopt});
+  }
+}
+
+TEST_CASE("[Statement] Bind generations", "[Statement]")
+{
+  auto binds = mysql_orm::InputBindArray<2>{};
+  auto i = 1;
+  auto s = std::string{"one"};
+  binds.bind(0, i);
+  binds.bind(1, s);
+  auto const version = binds.version();
+
+  // Same buffers and lengths.
+  i = 2;
+  binds.bind(0, i);
+  binds.bind(1, s);
+  CHECK(binds.version() == version);
+
+  s = "three";
+  binds.bind(1, s);
+  CHECK(!(binds.version() == version));
+}
+
+TEST_CASE("[Statement] Rebind text buffers", "[Statement]")
+{
+  auto binds = mysql_orm::OutputBindArray<1>{};
+  char* s = nullptr;
+  binds.bind<0>(0, s);
+  auto* const buffer = s;
+
+  // Buffered statements bind again on each execution.
+  binds.bind<0>(0, s);
+  CHECK(s == buffer);
+  binds.setBufferSize(0, 16);
+  binds.bind<0>(0, s);
+  CHECK(s == buffer);
+
+  binds.setBufferSize(0, 1024);
+  binds.bind<0>(0, s);
+  CHECK(binds.data()[0].buffer == s);
+  CHECK(binds.data()[0].buffer_length == 1024);
+  delete[] s;
+}
+
+TEST_CASE("[Statement] Re-execute with references", "[Statement]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 3, "three"))");
+
+  auto i = 0;
+  auto s = std::string{"one"};
+  auto stmt = d.getAll<Record>()(
+                   Where{c<&Record::i>{} > ref{i} && c<&Record::s>{} != ref{s}})
+                  .build();
+  CHECK(stmt.execute().size() == 2);
+  i = 1;
+  CHECK(stmt.execute().size() == 2);
+  s = "three";
+  CHECK(stmt.execute().size() == 1);
+  CHECK(stmt.execute()[0].s == "two");
+}
+
+TEST_CASE("[Statement] Time binds", "[Statement]")
+{
+  auto binds = mysql_orm::InputBindArray<1>{};
+  auto time = std::tm{};
+  time.tm_year = 120;
+  time.tm_mday = 1;
+  binds.bind(0, time);
+  auto const version = binds.version();
+
+  // Rebinding only converts the value again.
+  time.tm_year = 121;
+  binds.bind(0, time);
+  CHECK(binds.version() == version);
+  auto const* mysql_time =
+      static_cast<MYSQL_TIME const*>(binds.data()[0].buffer);
+  CHECK(mysql_time->year == 2021);
+
+  // Copies have storage of their own.
+  auto copy = binds;
+  auto const* copy_time =
+      static_cast<MYSQL_TIME const*>(copy.data()[0].buffer);
+  CHECK(copy_time != mysql_time);
+  CHECK(copy_time->year == 2021);
+
+  // Arrays with less time storage than slots use the storage they are given.
+  auto compact = mysql_orm::InputBindArray<3, 1>{};
+  auto const i = 1;
+  auto time_idx = std::size_t{0};
+  compact.bind(0, i, time_idx);
+  compact.bind(1, time, time_idx);
+  compact.bind(2, i, time_idx);
+  CHECK(time_idx == 1);
+  auto compact_copy = compact;
+  CHECK(compact_copy.data()[0].buffer == &i);
+  auto const* compact_time =
+      static_cast<MYSQL_TIME const*>(compact_copy.data()[1].buffer);
+  CHECK(compact_time != compact.data()[1].buffer);
+  CHECK(compact_time->year == 2021);
+}
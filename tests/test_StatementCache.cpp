@@ -0,0 +1,81 @@
+#include <mysql_orm/StatementCache.hpp>
+
+#include <catch_amalgamated.hpp>
+
+#include <Record.hh>
+#include <mysql_orm/Database.hpp>
+#include <mysql_orm/Where.hpp>
+
+using mysql_orm::c;
+using mysql_orm::Connection;
+using mysql_orm::Limit;
+using mysql_orm::make_column;
+using mysql_orm::make_database;
+using mysql_orm::make_table;
+using mysql_orm::ref;
+using mysql_orm::Where;
+
+TEST_CASE("[StatementCache] Statements are reused", "[StatementCache]")
+{
+  auto table_records = make_table("records",
+                                  make_column<&Record::id>("id"),
+                                  make_column<&Record::i>("i"),
+                                  make_column<&Record::s>("s"));
+  auto connection =
+      Connection{"localhost", 3306, "mysql_orm_test", "", "mysql_orm_test_db"};
+  auto d = make_database(connection, table_records);
+
+  d.recreate();
+  d.execute(
+      "INSERT INTO `records` (`id`, `i`, `s`) VALUES "
+      R"((1, 1, "one"),)"
+      R"((2, 2, "two"),)"
+      R"((3, 4, "four"))");
+
+  auto& cache = *d.getStatementCache();
+  cache.clear();
+
+  SECTION("Same query")
+  {
+    for (auto i = 0; i < 3; ++i)
+    {
+      auto const res = d.getAll<Record>()();
+      REQUIRE(res.size() == 3);
+      CHECK(cache.size() == 1);
+    }
+  }
+
+  SECTION("Different values, same shape")
+  {
+    auto const one = d.getAll<Record>()(Where{c<&Record::i>{} == 1})();
+    auto const four = d.getAll<Record>()(Where{c<&Record::i>{} == 4})();
+    CHECK(cache.size() == 1);
+    REQUIRE(one.size() == 1);
+    CHECK(one[0] == Record{1, 1, "one"});
+    REQUIRE(four.size() == 1);
+    CHECK(four[0] == Record{3, 4, "four"});
+  }
+
+  SECTION("Simultaneous statements")
+  {
+    auto a = d.getAll<Record>().build();
+    auto b = d.getAll<Record>().build();
+    CHECK(cache.size() == 0);
+    CHECK(a.execute().size() == 3);
+    CHECK(b.execute().size() == 3);
+  }
+
+  SECTION("LRU eviction")
+  {
+    cache.setCapacity(2);
+    d.getAll<Record>()();
+    d.getAll<Record>()(Limit<1>{})();
+    d.getAll<Record>()(Limit<2>{})();
+    CHECK(cache.size() == 2);
+    CHECK(d.getAll<Record>()(Limit<2>{})().size() == 2);
+    cache.setCapacity(0);
+    CHECK(cache.size() == 0);
+    CHECK(d.getAll<Record>()().size() == 3);
+    CHECK(cache.size() == 0);
+  }
+}
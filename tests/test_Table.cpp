@@ -2,14 +2,30 @@
 
 #include <catch_amalgamated.hpp>
 
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
 #include <string>
 
 #include <Record.hh>
 #include <Utils.hh>
 
 using mysql_orm::c;
+using mysql_orm::Engine;
+using mysql_orm::KeyBlockSize;
 using mysql_orm::make_column;
+using mysql_orm::make_index;
+using mysql_orm::make_primary_key;
 using mysql_orm::make_table;
+using mysql_orm::make_unique;
+using mysql_orm::make_varchar;
+using mysql_orm::PartitionByHash;
+using mysql_orm::PartitionByRange;
+using mysql_orm::PrefixLength;
+using mysql_orm::PrimaryKey;
+using mysql_orm::RowFormat;
+using mysql_orm::RowFormatType;
+using mysql_orm::StorageEngine;
 using mysql_orm::Where;
 
 TEST_CASE("Create statement", "[Table]")
@@ -28,6 +44,132 @@ TEST_CASE("Create statement", "[Table]")
           ")");
   }
 
+  SECTION("Indexes")
+  {
+    auto t = make_table(
+        "record",
+        make_column<&MixedRecord::id>("id", PrimaryKey{}),
+        make_index<&MixedRecord::i>("i"),
+        make_column<&MixedRecord::i>("i"),
+        make_column<&MixedRecord::s>("foo"),
+        make_unique<&MixedRecord::s, &MixedRecord::i>(
+            "foo_i", PrefixLength<&MixedRecord::s, 16>{}));
+    CHECK(t.getSchema() ==
+          "CREATE TABLE `record` (\n"
+          "  `id` INTEGER UNSIGNED NOT NULL PRIMARY KEY,\n"
+          "  `i` INTEGER NOT NULL,\n"
+          "  `foo` TEXT,\n"
+          "  INDEX `i` (`i`),\n"
+          "  UNIQUE INDEX `foo_i` (`foo`(16), `i`)\n"
+          ")");
+  }
+
+  SECTION("Index on a VARCHAR")
+  {
+    auto t = make_table("record",
+                        make_column<&MixedRecord::id>("id"),
+                        make_varchar<32, &MixedRecord::s>("foo"),
+                        make_index<&MixedRecord::s>("foo"));
+    CHECK(t.getSchema() ==
+          "CREATE TABLE `record` (\n"
+          "  `id` INTEGER UNSIGNED NOT NULL,\n"
+          "  `foo` VARCHAR(32),\n"
+          "  INDEX `foo` (`foo`)\n"
+          ")");
+  }
+
+  SECTION("Table options")
+  {
+    auto t = make_table("record",
+                        make_column<&MixedRecord::id>("id", PrimaryKey{}),
+                        make_column<&MixedRecord::i>("i"),
+                        Engine<StorageEngine::InnoDB>{},
+                        RowFormat<RowFormatType::Compressed>{},
+                        KeyBlockSize<8>{},
+                        PartitionByHash<&MixedRecord::id, 4>{});
+    CHECK(t.getSchema() ==
+          "CREATE TABLE `record` (\n"
+          "  `id` INTEGER UNSIGNED NOT NULL PRIMARY KEY,\n"
+          "  `i` INTEGER NOT NULL\n"
+          ") ENGINE=InnoDB ROW_FORMAT=COMPRESSED KEY_BLOCK_SIZE=8\n"
+          "PARTITION BY HASH(`id`) PARTITIONS 4");
+  }
+
+  SECTION("Range partitions")
+  {
+    auto t = make_table("record",
+                        make_column<&RecordWithTime::id>("id"),
+                        make_column<&RecordWithTime::time>("time"),
+                        PartitionByRange<&RecordWithTime::time>{});
+    CHECK(t.getSchema() ==
+          "CREATE TABLE `record` (\n"
+          "  `id` INTEGER UNSIGNED NOT NULL,\n"
+          "  `time` DATETIME NOT NULL\n"
+          ")\n"
+          "PARTITION BY RANGE COLUMNS(`time`) "
+          "(PARTITION `pmax` VALUES LESS THAN (MAXVALUE))");
+
+    auto bound = std::tm{};
+    bound.tm_year = 2026 - 1900;
+    bound.tm_mon = 9;
+    bound.tm_mday = 1;
+    CHECK(t.getAddPartitionQuery("p202609", bound) ==
+          "ALTER TABLE `record` REORGANIZE PARTITION `pmax` INTO "
+          "(PARTITION `p202609` VALUES LESS THAN ('2026-10-01 00:00:00'), "
+          "PARTITION `pmax` VALUES LESS THAN (MAXVALUE))");
+    CHECK(t.getDropPartitionQuery("p202609") ==
+          "ALTER TABLE `record` DROP PARTITION `p202609`");
+    CHECK_THROWS_AS(t.getDropPartitionQuery("p`"), std::invalid_argument);
+    CHECK_THROWS_AS(t.getDropPartitionQuery("pmax"), std::invalid_argument);
+
+    bound.tm_year = 10000 - 1900;
+    CHECK_THROWS_AS(t.getAddPartitionQuery("p10000", bound),
+                    std::invalid_argument);
+  }
+
+  SECTION("Range partitions on time points")
+  {
+    using namespace std::chrono_literals;
+    auto t = make_table(
+        "record",
+        make_column<&RecordWithChrono::id>("id"),
+        make_column<&RecordWithChrono::time>("time"),
+        make_primary_key<&RecordWithChrono::id, &RecordWithChrono::time>(),
+        PartitionByRange<&RecordWithChrono::time>{});
+    auto const day = mysql_orm::sys_days{mysql_orm::days{20727}};
+    auto const bound = mysql_orm::sys_seconds{day} + 12h;
+    CHECK(t.getAddPartitionQuery("p202610", bound) ==
+          "ALTER TABLE `record` REORGANIZE PARTITION `pmax` INTO "
+          "(PARTITION `p202610` VALUES LESS THAN ('2026-10-01 12:00:00'), "
+          "PARTITION `pmax` VALUES LESS THAN (MAXVALUE))");
+    CHECK(mysql_orm::details::partitionBoundToString(day) == "'2026-10-01'");
+    auto const precise =
+        mysql_orm::sys_time<std::chrono::microseconds>{day} + 1500ms;
+    CHECK(mysql_orm::details::partitionBoundToString(precise) ==
+          "'2026-10-01 00:00:01.500000'");
+    CHECK_THROWS_AS(
+        mysql_orm::details::partitionBoundToString(day - 24h * 800000),
+        std::invalid_argument);
+  }
+
+  SECTION("Composite primary key")
+  {
+    auto t = make_table(
+        "record",
+        make_column<&RecordWithTime::id>("id"),
+        make_column<&RecordWithTime::time>("time"),
+        make_primary_key<&RecordWithTime::id, &RecordWithTime::time>(),
+        PartitionByRange<&RecordWithTime::time>{});
+    CHECK(t.getSchema() ==
+          "CREATE TABLE `record` (\n"
+          "  `id` INTEGER UNSIGNED NOT NULL,\n"
+          "  `time` DATETIME NOT NULL,\n"
+          "  PRIMARY KEY (`id`, `time`)\n"
+          ")\n"
+          "PARTITION BY RANGE COLUMNS(`time`) "
+          "(PARTITION `pmax` VALUES LESS THAN (MAXVALUE))");
+  }
+
   // Should not compile
   // SECTION("Mismatched records")
   // {